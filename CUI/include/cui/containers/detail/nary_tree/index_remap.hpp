@@ -0,0 +1,82 @@
+#ifndef CUI_NARY_TREE_INDEX_REMAP_HPP
+#define CUI_NARY_TREE_INDEX_REMAP_HPP
+
+#include <algorithm>
+#include <vector>
+
+#include <aliases.hpp>
+
+namespace cui::nary {
+
+/// \brief Describes how node indices moved after a structural change of a \sa cui::NaryTree
+/// \details Indices below \sa IndexRemap::position() are unchanged, which lets caches keyed by node index
+/// keep everything in front of the change and only rebuild the affected range
+class IndexRemap
+{
+public:
+	using size_type = std::size_t;
+	static constexpr size_type npos = -1;
+
+	IndexRemap() = default;
+
+	/// \brief Describes the insertion of a contiguous range of nodes
+	/// \param p_position The index of the first inserted node
+	/// \param p_count The amount of inserted nodes
+	[[nodiscard]] static auto insertion(const size_type p_position, const size_type p_count) -> IndexRemap {
+		IndexRemap remap;
+		remap.position_ = p_position;
+		remap.inserted_ = p_count;
+		return remap;
+	}
+
+	/// \brief Describes the removal of a set of nodes
+	/// \param p_removed The old indices of the removed nodes in ascending order
+	[[nodiscard]] static auto removal(std::vector<size_type>&& p_removed) -> IndexRemap {
+		IndexRemap remap;
+		remap.position_ = p_removed.empty() ? npos : p_removed.front();
+		remap.removed_ = std::move(p_removed);
+		return remap;
+	}
+
+	/// \brief Maps an index from before the change to the one after
+	/// \details O(1) for insertions, O(log k) for the removal of k nodes
+	/// \param index The old index, \sa IndexRemap::npos maps to itself
+	/// \returns The new index or \sa IndexRemap::npos if the node was removed
+	[[nodiscard]] auto map(const size_type index) const noexcept -> size_type {
+		if (index == npos || index < position_) return index;
+		if (removed_.empty()) return index + inserted_;
+
+		const auto it = std::lower_bound(removed_.begin(), removed_.end(), index);
+		if (it != removed_.end() && *it == index) return npos;
+		return index - static_cast<size_type>(it - removed_.begin());
+	}
+
+	[[nodiscard]] auto position() const noexcept -> size_type {
+		return position_;
+	}
+
+	[[nodiscard]] auto inserted() const noexcept -> size_type {
+		return inserted_;
+	}
+
+	[[nodiscard]] auto removed() const noexcept -> const std::vector<size_type>& {
+		return removed_;
+	}
+
+	[[nodiscard]] bool is_insertion() const noexcept {
+		return inserted_ != 0;
+	}
+
+	[[nodiscard]] bool empty() const noexcept {
+		return inserted_ == 0 && removed_.empty();
+	}
+
+private:
+	size_type position_ = npos;
+	size_type inserted_ = 0;
+	std::vector<size_type> removed_;
+};
+
+}	 // namespace cui::nary
+
+#endif	  // CUI_NARY_TREE_INDEX_REMAP_HPP
@@ -14,11 +14,12 @@ public:
 	using data_type = T;
 	using size_type = std::size_t;
 	using vec_t = std::vector<size_type>;
+	static constexpr size_type no_parent = -1;
 
 	Node() = default;
-	Node(const data_type& val) : data_(val), depth_(0) {}
-	Node(const data_type& val, const vec_t& p_children, const size_type p_depth)
-		: data_(val), children_(p_children), depth_(p_depth) {}
+	Node(const data_type& val) : data_(val), depth_(0), parent_(no_parent) {}
+	Node(const data_type& val, const vec_t& p_children, const size_type p_depth, const size_type p_parent = no_parent)
+		: data_(val), children_(p_children), depth_(p_depth), parent_(p_parent) {}
 
 	[[nodiscard]] auto data() noexcept -> data_type& {
 		return data_;
@@ -44,6 +45,14 @@ public:
 		return depth_;
 	}
 
+	[[nodiscard]] auto parent() noexcept -> size_type& {
+		return parent_;
+	}
+
+	[[nodiscard]] auto parent() const noexcept -> size_type {
+		return parent_;
+	}
+
 	void add_child(const size_type index) {
 		children_.push_back(index);
 	}
@@ -52,6 +61,7 @@ private:
 	data_type data_;
 	vec_t children_;
 	size_type depth_;
+	size_type parent_ = no_parent;
 };
 
 }	 // namespace cui::nary
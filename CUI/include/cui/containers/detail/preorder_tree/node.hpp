@@ -0,0 +1,82 @@
+#ifndef CUI_PREORDER_TREE_NODE_HPP
+#define CUI_PREORDER_TREE_NODE_HPP
+
+#include <utility>
+
+#include <aliases.hpp>
+
+namespace cui::preorder {
+
+/// \brief Node of a \sa cui::PreorderTree
+/// \details Holds no children vector, the first child directly follows the node and the children are chained
+/// through \sa Node::next_sibling(). The subtree of a node spans \sa Node::subtree_size() slots starting at it
+template <typename T>
+class Node
+{
+public:
+	using data_type = T;
+	using size_type = std::size_t;
+	static constexpr size_type npos = -1;
+	static constexpr size_type no_parent = npos;
+
+	Node() = default;
+	Node(const data_type& val, const size_type p_depth, const size_type p_parent)
+		: data_(val), depth_(p_depth), parent_(p_parent) {}
+	Node(data_type&& val, const size_type p_depth, const size_type p_parent)
+		: data_(std::move(val)), depth_(p_depth), parent_(p_parent) {}
+
+	[[nodiscard]] auto data() noexcept -> data_type& {
+		return data_;
+	}
+
+	[[nodiscard]] auto data() const noexcept -> const data_type& {
+		return data_;
+	}
+
+	[[nodiscard]] auto depth() noexcept -> size_type& {
+		return depth_;
+	}
+
+	[[nodiscard]] auto depth() const noexcept -> size_type {
+		return depth_;
+	}
+
+	[[nodiscard]] auto parent() noexcept -> size_type& {
+		return parent_;
+	}
+
+	[[nodiscard]] auto parent() const noexcept -> size_type {
+		return parent_;
+	}
+
+	[[nodiscard]] auto subtree_size() noexcept -> size_type& {
+		return subtree_size_;
+	}
+
+	[[nodiscard]] auto subtree_size() const noexcept -> size_type {
+		return subtree_size_;
+	}
+
+	[[nodiscard]] auto next_sibling() noexcept -> size_type& {
+		return next_sibling_;
+	}
+
+	[[nodiscard]] auto next_sibling() const noexcept -> size_type {
+		return next_sibling_;
+	}
+
+	[[nodiscard]] bool has_children() const noexcept {
+		return subtree_size_ > 1;
+	}
+
+private:
+	data_type data_;
+	size_type depth_ = 0;
+	size_type parent_ = no_parent;
+	size_type subtree_size_ = 1;
+	size_type next_sibling_ = npos;
+};
+
+}	 // namespace cui::preorder
+
+#endif	  // CUI_PREORDER_TREE_NODE_HPP
@@ -6,6 +6,7 @@
 #include <vector>
 
 #include <aliases.hpp>
+#include <containers/detail/nary_tree/index_remap.hpp>
 #include <containers/detail/nary_tree/node.hpp>
 
 namespace cui {
@@ -19,6 +20,9 @@ public:
 	using data_type = typename node_type::data_type;
 	using iterator = typename std::vector<node_type>::iterator;
 	using const_iterator = typename std::vector<node_type>::const_iterator;
+	using remap_t = nary::IndexRemap;
+	static constexpr size_type no_parent = node_type::no_parent;
+	static constexpr size_type npos = remap_t::npos;
 
 	[[nodiscard]] auto length() const noexcept -> size_type {
 		return vec_.size();
@@ -80,6 +84,10 @@ public:
 		return vec_.at(idx);
 	}
 
+	void reserve(const size_type count) {
+		vec_.reserve(count);
+	}
+
 	template <typename... Args>
 	void emplace_back(Args&&... args) {
 		vec_.emplace_back(std::move(args)...);
@@ -95,33 +103,151 @@ public:
 
 	void add_node(const data_type& val, const size_type idx) {
 		vec_[idx].add_child(length());
-		vec_.emplace_back(val, vec_[idx].depth() + 1);
+		vec_.emplace_back(val, typename node_type::vec_t{}, vec_[idx].depth() + 1, idx);
 	}
 
 	void add_node(data_type&& val, const size_type idx) {
 		vec_[idx].add_child(length());
-		vec_.emplace_back(std::move(val), vec_[idx].depth() + 1);
+		vec_.emplace_back(std::move(val), typename node_type::vec_t{}, vec_[idx].depth() + 1, idx);
 	}
 
-	void remove_node(const size_type idx) {
-		vec_[idx].erase(vec_.begin() + idx);
-		for (auto it = vec_.begin(); it != vec_.end(); ++it) {
-			std::remove(it->begin(), it->end(), idx);
-		}
+	auto insert_subtree(size_type parent, NaryTree&& subtree, size_type child_position = npos) -> remap_t;
+
+	auto remove_subtree(size_type idx) -> remap_t;
+
+	/// \brief Removes a node together with its descendants, see \sa NaryTree::remove_subtree()
+	auto remove_node(const size_type idx) -> remap_t {
+		return remove_subtree(idx);
 	}
 
-	void pop_node() {
-		vec_.pop_back();
-		const auto idx = length().size();
-		for (auto it = vec_.begin(); it != vec_.end(); ++it) {
-			std::remove(it->begin(), it->end(), idx);
-		}
+	/// \brief Removes the last node together with its descendants, see \sa NaryTree::remove_subtree()
+	auto pop_node() -> remap_t {
+		if (vec_.empty()) return {};
+		return remove_subtree(length() - 1);
 	}
 
+	[[nodiscard]] auto subtree_end(size_type idx) const noexcept -> size_type;
+
 protected:
 	std::vector<node_type> vec_;
 };
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Inserts a tree as a subtree of a node
+/// \details The nodes of the inserted tree keep their relative links, parent and child indices, and depths. Its
+/// top level nodes become children of the parent. The nodes are inserted as one contiguous range right where
+/// the subtree of the new sibling starts, or behind the last descendant of the parent, so a tree stored in
+/// pre-order stays in pre-order. Every index at or behind the insertion point is shifted in a single pass.
+/// O(n + m) for n existing and m inserted nodes
+/// \param parent The index of the parent, \sa NaryTree::no_parent inserts top level nodes
+/// \param subtree The tree to insert, its nodes are moved out
+/// \param child_position The position among the children of the parent, \sa NaryTree::npos appends
+/// \returns The remap describing the inserted range
+template <typename T>
+auto NaryTree<T>::insert_subtree(const size_type parent, NaryTree&& subtree, size_type child_position) -> remap_t {
+	const auto count = subtree.length();
+	if (count == 0) return {};
+
+	std::vector<size_type> siblings;
+	if (parent == no_parent) {
+		for (size_type i = 0; i < length(); ++i) {
+			if (vec_[i].parent() == no_parent) siblings.push_back(i);
+		}
+	} else {
+		siblings = vec_[parent].children();
+	}
+	if (child_position > siblings.size()) child_position = siblings.size();
+
+	size_type position = length();
+	if (child_position < siblings.size()) {
+		position = siblings[child_position];
+	} else if (parent != no_parent) {
+		position = subtree_end(parent);
+	}
+
+	for (auto& node : vec_) {
+		for (auto& child : node.children()) {
+			if (child >= position) child += count;
+		}
+		if (node.parent() != no_parent && node.parent() >= position) node.parent() += count;
+	}
+
+	const auto new_parent = parent != no_parent && parent >= position ? parent + count : parent;
+	const auto base_depth = parent == no_parent ? 0 : vec_[parent].depth() + 1;
+	std::vector<size_type> roots;
+	for (size_type i = 0; i < count; ++i) {
+		auto& node = subtree.vec_[i];
+		for (auto& child : node.children()) child += position;
+		node.depth() += base_depth;
+		if (node.parent() == no_parent) {
+			node.parent() = new_parent;
+			roots.push_back(position + i);
+		} else {
+			node.parent() += position;
+		}
+	}
+	vec_.insert(vec_.begin() + position, std::make_move_iterator(subtree.vec_.begin()), std::make_move_iterator(subtree.vec_.end()));
+
+	if (parent != no_parent) {
+		auto& children = vec_[new_parent].children();
+		children.insert(children.begin() + child_position, roots.begin(), roots.end());
+	}
+
+	return remap_t::insertion(position, count);
+}
+
+/// \brief Removes a node together with all of its descendants
+/// \details Marks the subtree, then compacts the storage, remaps every child and parent index and drops the
+/// node from the children of its parent in a single pass. O(n)
+/// \param idx The index of the node to remove
+/// \returns The remap describing the removed indices
+template <typename T>
+auto NaryTree<T>::remove_subtree(const size_type idx) -> remap_t {
+	if (idx >= length()) return {};
+
+	std::vector<bool> removed(length(), false);
+	std::vector<size_type> removed_indices;
+	std::vector<size_type> pending{idx};
+	while (!pending.empty()) {
+		const auto current = pending.back();
+		pending.pop_back();
+		removed[current] = true;
+		removed_indices.push_back(current);
+		pending.insert(pending.end(), vec_[current].children().begin(), vec_[current].children().end());
+	}
+	std::sort(removed_indices.begin(), removed_indices.end());
+
+	std::vector<size_type> new_index(length(), npos);
+	size_type next = 0;
+	for (size_type i = 0; i < length(); ++i) {
+		if (!removed[i]) new_index[i] = next++;
+	}
+
+	for (size_type i = 0; i < length(); ++i) {
+		if (removed[i]) continue;
+
+		auto& node = vec_[i];
+		auto& children = node.children();
+		children.erase(std::remove(children.begin(), children.end(), idx), children.end());
+		for (auto& child : children) child = new_index[child];
+		if (node.parent() != no_parent) node.parent() = new_index[node.parent()];
+		if (new_index[i] != i) vec_[new_index[i]] = std::move(node);
+	}
+	vec_.erase(vec_.begin() + next, vec_.end());
+
+	return remap_t::removal(std::move(removed_indices));
+}
+
+/// \brief Gets the index one past the last descendant of a node
+/// \details Follows the last child down, which is exact for trees stored in pre-order
+/// \param idx The index of the node
+template <typename T>
+auto NaryTree<T>::subtree_end(size_type idx) const noexcept -> size_type {
+	while (!vec_[idx].children().empty()) idx = vec_[idx].children().back();
+	return idx + 1;
+}
+
 }	 // namespace cui
 
 #endif	  // CUI_NARY_TREE_HPP
\ No newline at end of file
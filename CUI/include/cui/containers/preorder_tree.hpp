@@ -0,0 +1,283 @@
+#ifndef CUI_PREORDER_TREE_HPP
+#define CUI_PREORDER_TREE_HPP
+
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <aliases.hpp>
+#include <containers/detail/nary_tree/index_remap.hpp>
+#include <containers/detail/preorder_tree/node.hpp>
+#include <containers/nary_tree.hpp>
+
+namespace cui {
+
+namespace preorder {
+
+/// \brief A contiguous slice of a \sa cui::PreorderTree
+template <typename It>
+class Range
+{
+public:
+	using size_type = std::size_t;
+
+	Range(It p_first, It p_last) : first_(p_first), last_(p_last) {}
+
+	[[nodiscard]] auto begin() const noexcept -> It {
+		return first_;
+	}
+
+	[[nodiscard]] auto end() const noexcept -> It {
+		return last_;
+	}
+
+	[[nodiscard]] auto size() const noexcept -> size_type {
+		return static_cast<size_type>(std::distance(first_, last_));
+	}
+
+private:
+	It first_;
+	It last_;
+};
+
+}	 // namespace preorder
+
+/// \brief A tree stored in pre-order without per-node children vectors
+/// \details Alternative storage to \sa cui::NaryTree. Every subtree is the contiguous slice starting at its
+/// node and spanning \sa preorder::Node::subtree_size() nodes, so layout, culling, dirty propagation and
+/// serialization of a subtree are linear scans. The first child of a node directly follows it and siblings
+/// are chained through \sa preorder::Node::next_sibling(), top level nodes included. Structural changes return
+/// the same \sa nary::IndexRemap as \sa cui::NaryTree so index keyed caches can follow either storage
+template <typename T>
+class PreorderTree
+{
+public:
+	using node_type = preorder::Node<T>;
+	using size_type = std::size_t;
+	using data_type = typename node_type::data_type;
+	using iterator = typename std::vector<node_type>::iterator;
+	using const_iterator = typename std::vector<node_type>::const_iterator;
+	using remap_t = nary::IndexRemap;
+	static constexpr size_type npos = node_type::npos;
+	static constexpr size_type no_parent = node_type::no_parent;
+
+	PreorderTree() = default;
+
+	explicit PreorderTree(const NaryTree<T>& tree);
+
+	[[nodiscard]] auto to_nary() const -> NaryTree<T>;
+
+	[[nodiscard]] auto length() const noexcept -> size_type {
+		return vec_.size();
+	}
+
+	[[nodiscard]] auto begin() noexcept -> iterator {
+		return vec_.begin();
+	}
+
+	[[nodiscard]] auto begin() const noexcept -> const_iterator {
+		return vec_.cbegin();
+	}
+
+	[[nodiscard]] auto end() noexcept -> iterator {
+		return vec_.end();
+	}
+
+	[[nodiscard]] auto end() const noexcept -> const_iterator {
+		return vec_.cend();
+	}
+
+	[[nodiscard]] auto operator[](const size_type idx) noexcept -> node_type& {
+		return vec_[idx];
+	}
+
+	[[nodiscard]] auto operator[](const size_type idx) const noexcept -> const node_type& {
+		return vec_[idx];
+	}
+
+	/// \brief Gets the first child of a node
+	/// \returns The index of the first child or \sa PreorderTree::npos for a leaf
+	[[nodiscard]] auto first_child(const size_type idx) const noexcept -> size_type {
+		return vec_[idx].has_children() ? idx + 1 : npos;
+	}
+
+	/// \brief Gets the index one past the last descendant of a node
+	[[nodiscard]] auto subtree_end(const size_type idx) const noexcept -> size_type {
+		return idx + vec_[idx].subtree_size();
+	}
+
+	/// \brief Gets a node together with all of its descendants as a slice
+	[[nodiscard]] auto subtree(const size_type idx) noexcept -> preorder::Range<iterator> {
+		return {vec_.begin() + static_cast<std::ptrdiff_t>(idx), vec_.begin() + static_cast<std::ptrdiff_t>(subtree_end(idx))};
+	}
+
+	[[nodiscard]] auto subtree(const size_type idx) const noexcept -> preorder::Range<const_iterator> {
+		return {vec_.cbegin() + static_cast<std::ptrdiff_t>(idx), vec_.cbegin() + static_cast<std::ptrdiff_t>(subtree_end(idx))};
+	}
+
+	/// \brief Calls a function with the index of every child of a node, in order
+	/// \param idx The index of the node, \sa PreorderTree::no_parent visits the top level nodes
+	template <typename Fn>
+	void for_each_child(const size_type idx, Fn&& fn) const {
+		auto child = idx == no_parent ? (vec_.empty() ? npos : 0) : first_child(idx);
+		for (; child != npos; child = vec_[child].next_sibling()) fn(child);
+	}
+
+	auto add_node(data_type val, size_type parent = no_parent) -> size_type;
+
+	auto insert_subtree(size_type parent, PreorderTree&& subtree, size_type child_position = npos) -> remap_t;
+
+	auto remove_subtree(size_type idx) -> remap_t;
+
+private:
+	std::vector<node_type> vec_;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Converts a \sa cui::NaryTree, which may be stored in any order
+/// \details Visits the top level nodes in index order and every node's children in their list order. O(n)
+/// \param tree The tree to convert
+template <typename T>
+PreorderTree<T>::PreorderTree(const NaryTree<T>& tree) {
+	vec_.reserve(tree.length());
+
+	std::vector<size_type> pending;
+	for (size_type i = tree.length(); i-- > 0;) {
+		if (tree[i].parent() == no_parent) pending.push_back(i);
+	}
+
+	std::vector<size_type> new_index(tree.length(), npos);
+	std::vector<size_type> last_child(tree.length(), npos);
+	auto last_root = npos;
+	while (!pending.empty()) {
+		const auto current = pending.back();
+		pending.pop_back();
+
+		const auto& node = tree[current];
+		const auto parent = node.parent() == no_parent ? no_parent : new_index[node.parent()];
+		const auto idx = vec_.size();
+		new_index[current] = idx;
+		vec_.emplace_back(node.data(), parent == no_parent ? 0 : vec_[parent].depth() + 1, parent);
+
+		auto& previous = parent == no_parent ? last_root : last_child[parent];
+		if (previous != npos) vec_[previous].next_sibling() = idx;
+		previous = idx;
+
+		pending.insert(pending.end(), node.children().rbegin(), node.children().rend());
+	}
+
+	for (size_type i = vec_.size(); i-- > 0;) {
+		const auto parent = vec_[i].parent();
+		if (parent != no_parent) vec_[parent].subtree_size() += vec_[i].subtree_size();
+	}
+}
+
+/// \brief Converts back to a \sa cui::NaryTree with the same indices
+template <typename T>
+auto PreorderTree<T>::to_nary() const -> NaryTree<T> {
+	NaryTree<T> tree;
+	for (const auto& node : vec_) {
+		if (node.parent() == no_parent) {
+			tree.add_node(node.data());
+		} else {
+			tree.add_node(node.data(), node.parent());
+		}
+	}
+	return tree;
+}
+
+/// \brief Adds a node as the last child of a parent
+/// \details Shifts every node behind the subtree of the parent, see \sa PreorderTree::insert_subtree()
+/// \param val The data of the node
+/// \param parent The index of the parent, \sa PreorderTree::no_parent adds a top level node
+/// \returns The index of the new node
+template <typename T>
+auto PreorderTree<T>::add_node(data_type val, const size_type parent) -> size_type {
+	PreorderTree single;
+	single.vec_.emplace_back(std::move(val), 0, no_parent);
+	return insert_subtree(parent, std::move(single)).position();
+}
+
+/// \brief Inserts a tree as a subtree of a node
+/// \details The inserted tree becomes one contiguous slice at the position of the new sibling, or behind the
+/// subtree of the parent when appending. Its top level nodes become children of the parent. Nodes behind the
+/// slice are shifted and the ancestors of the parent grow in a single pass. O(n + m) for n existing and m
+/// inserted nodes
+/// \param parent The index of the parent, \sa PreorderTree::no_parent inserts top level nodes
+/// \param subtree The tree to insert, its nodes are moved out
+/// \param child_position The position among the children of the parent, \sa PreorderTree::npos appends
+/// \returns The remap describing the inserted range
+template <typename T>
+auto PreorderTree<T>::insert_subtree(const size_type parent, PreorderTree&& subtree, const size_type child_position) -> remap_t {
+	const auto count = subtree.length();
+	if (count == 0) return {};
+
+	auto previous = npos;
+	auto following = parent == no_parent ? (vec_.empty() ? npos : 0) : first_child(parent);
+	for (size_type i = 0; i < child_position && following != npos; ++i) {
+		previous = following;
+		following = vec_[following].next_sibling();
+	}
+
+	const auto position = following != npos ? following : parent == no_parent ? length() : subtree_end(parent);
+	for (auto ancestor = parent; ancestor != no_parent; ancestor = vec_[ancestor].parent()) vec_[ancestor].subtree_size() += count;
+
+	for (auto& node : vec_) {
+		if (node.parent() != no_parent && node.parent() >= position) node.parent() += count;
+		if (node.next_sibling() != npos && node.next_sibling() >= position) node.next_sibling() += count;
+	}
+	if (previous != npos) vec_[previous].next_sibling() = position;
+
+	const auto base_depth = parent == no_parent ? 0 : vec_[parent].depth() + 1;
+	for (auto& node : subtree.vec_) {
+		node.depth() += base_depth;
+		const auto is_root = node.parent() == no_parent;
+		node.parent() = is_root ? parent : node.parent() + position;
+		if (node.next_sibling() != npos) {
+			node.next_sibling() += position;
+		} else if (is_root) {
+			node.next_sibling() = following == npos ? npos : following + count;
+		}
+	}
+	vec_.insert(vec_.begin() + static_cast<std::ptrdiff_t>(position),
+				std::make_move_iterator(subtree.vec_.begin()),
+				std::make_move_iterator(subtree.vec_.end()));
+
+	return remap_t::insertion(position, count);
+}
+
+/// \brief Removes a node together with all of its descendants
+/// \details Erases the slice of the subtree, unlinks it from its previous sibling, shrinks its ancestors and
+/// shifts the nodes behind it in a single pass. O(n)
+/// \param idx The index of the node to remove
+/// \returns The remap describing the removed indices
+template <typename T>
+auto PreorderTree<T>::remove_subtree(const size_type idx) -> remap_t {
+	if (idx >= length()) return {};
+
+	const auto count = vec_[idx].subtree_size();
+	const auto last = idx + count;
+	const auto parent = vec_[idx].parent();
+
+	auto previous = npos;
+	for_each_child(parent, [&](const size_type child) {
+		if (vec_[child].next_sibling() == idx) previous = child;
+	});
+	if (previous != npos) vec_[previous].next_sibling() = vec_[idx].next_sibling();
+	for (auto ancestor = parent; ancestor != no_parent; ancestor = vec_[ancestor].parent()) vec_[ancestor].subtree_size() -= count;
+
+	vec_.erase(vec_.begin() + static_cast<std::ptrdiff_t>(idx), vec_.begin() + static_cast<std::ptrdiff_t>(last));
+	for (auto& node : vec_) {
+		if (node.parent() != no_parent && node.parent() >= last) node.parent() -= count;
+		if (node.next_sibling() != npos && node.next_sibling() >= last) node.next_sibling() -= count;
+	}
+
+	std::vector<size_type> removed(count);
+	for (size_type i = 0; i < count; ++i) removed[i] = idx + i;
+	return remap_t::removal(std::move(removed));
+}
+
+}	 // namespace cui
+
+#endif	  // CUI_PREORDER_TREE_HPP
@@ -1,9 +1,9 @@
 #ifndef CUI_TRACKED_LIST_HPP
 #define CUI_TRACKED_LIST_HPP
 
-#include <exception>
 #include <initializer_list>
 #include <list>
+#include <stdexcept>
 
 namespace cui {
 
@@ -47,7 +47,7 @@ public:
 	}
 
 	void change_tracked_item(size_type idx) {
-		if (idx >= this->size()) throw cui::ct::CTException("Index exceeds current size! | Index: {}, Size: {}", idx, this->size());
+		if (idx >= this->size()) throw std::out_of_range("Index exceeds current size!");
 		tracker_ = idx;
 	}
 
@@ -1,10 +1,12 @@
 #ifndef CUI_SCENE_STATE_HPP
 #define CUI_SCENE_STATE_HPP
 
+#include <array>
 #include <functional>
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include <aliases.hpp>
 #include <tsl/hopscotch_map.h>
@@ -14,10 +16,14 @@ namespace cui {
 
 /// \brief Encapsulated \sa cui::SceneGraph that provides registering events
 /// \details Holds global and node-local events attached to be inspected on a specific
-/// outer event in a map
+/// outer event in a map. Every registration change recompiles the map into flat per-marker
+/// dispatch tables so that processing an outer event is an array index plus a linear call loop.
+/// Registration changes made by a handler while a \sa SceneState::DispatchScope is open are queued and
+/// applied when the outermost scope closes, so the running handler and the tables being walked stay valid
 /// \tparam TEventFunction Type of event function to be stored
 /// \tparam TEvent Type of outer event
-template <typename TEventFunction, typename TEvent>
+/// \tparam MarkerCount Amount of distinct outer event values, used to size the dispatch tables
+template <typename TEventFunction, typename TEvent, u64 MarkerCount>
 class SceneState
 {
 public:
@@ -27,10 +33,60 @@ public:
 	using event_map_t = tsl::hopscotch_map<std::string, event_t>;
 	using event_marker_map_t = tsl::hopscotch_map<outer_event_t, std::pair<event_map_t, event_map_t>>;
 
+	/// \brief A resolved handler; both pointers refer into the event marker map
+	struct Handler
+	{
+		const std::string* name;
+		const event_t* event;
+	};
+
+	/// \brief Flat list of resolved handlers for a single outer event
+	struct DispatchTable
+	{
+		std::vector<Handler> node_events;
+		std::vector<Handler> global_events;
+
+		[[nodiscard]] bool empty() const noexcept {
+			return node_events.empty() && global_events.empty();
+		}
+	};
+
+	using dispatch_tables_t = std::array<DispatchTable, MarkerCount>;
+	using deferred_change_t = std::function<void(SceneState&)>;
+
+	/// \brief Marks a dispatch in progress for as long as it lives, scopes may nest
+	class DispatchScope
+	{
+	public:
+		explicit DispatchScope(SceneState& p_state) : state_(p_state) {
+			++state_.dispatch_depth_;
+		}
+
+		DispatchScope(const DispatchScope&) = delete;
+		auto operator=(const DispatchScope&) -> DispatchScope& = delete;
+
+		~DispatchScope() {
+			state_.end_dispatch();
+		}
+
+	private:
+		SceneState& state_;
+	};
+
+	static constexpr u64 marker_count = MarkerCount;
+
 	SceneState(const graph_t& p_graph) : graph_(p_graph) {}
 
 	SceneState(graph_t&& p_graph) : graph_(std::move(p_graph)) {}
 
+	SceneState(const SceneState& rhs);
+
+	SceneState(SceneState&& rhs);
+
+	auto operator=(const SceneState& rhs) -> SceneState&;
+
+	auto operator=(SceneState&& rhs) -> SceneState&;
+
 	void register_event(const outer_event_t& type, const std::string& name, event_t&& event);
 	void register_event(const outer_event_t& type, std::string&& name, event_t&& event);
 
@@ -58,91 +114,189 @@ public:
 
 	[[nodiscard]] auto registered_global_events(const outer_event_t& event_type) const -> const event_map_t&;
 
+	[[nodiscard]] auto dispatch_table(const outer_event_t& type) const noexcept -> const DispatchTable&;
+
+	[[nodiscard]] bool has_subscribers(const outer_event_t& type) const noexcept;
+
+	[[nodiscard]] auto unsubscribed_markers() const -> std::vector<outer_event_t>;
+
+	[[nodiscard]] bool dispatching() const noexcept {
+		return dispatch_depth_ > 0;
+	}
+
 private:
+	void rebuild_dispatch_tables();
+	void end_dispatch();
+
 	graph_t graph_;
 	event_marker_map_t marked_sections_;
+	dispatch_tables_t dispatch_tables_;
+	u32 dispatch_depth_ = 0;
+	std::vector<deferred_change_t> deferred_changes_;
 };
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// \brief Copy constructs the scene state
+/// \details The dispatch tables are recompiled since they point into the copied event marker map
+template <typename TEventFunction, typename TEvent, u64 MarkerCount>
+SceneState<TEventFunction, TEvent, MarkerCount>::SceneState(const SceneState& rhs) : graph_(rhs.graph_), marked_sections_(rhs.marked_sections_) {
+	rebuild_dispatch_tables();
+}
+
+/// \brief Move constructs the scene state
+/// \details The dispatch tables are recompiled since they point into the moved event marker map
+template <typename TEventFunction, typename TEvent, u64 MarkerCount>
+SceneState<TEventFunction, TEvent, MarkerCount>::SceneState(SceneState&& rhs) : graph_(std::move(rhs.graph_)), marked_sections_(std::move(rhs.marked_sections_)) {
+	rebuild_dispatch_tables();
+}
+
+/// \brief Copy assigns the scene state
+/// \details The dispatch tables are recompiled since they point into the copied event marker map
+/// \param rhs Right side scene state
+/// \returns A reference to this scene state
+template <typename TEventFunction, typename TEvent, u64 MarkerCount>
+auto SceneState<TEventFunction, TEvent, MarkerCount>::operator=(const SceneState& rhs) -> SceneState& {
+	graph_ = rhs.graph_;
+	marked_sections_ = rhs.marked_sections_;
+	rebuild_dispatch_tables();
+	return *this;
+}
+
+/// \brief Move assigns the scene state
+/// \details The dispatch tables are recompiled since they point into the moved event marker map
+/// \param rhs Right side scene state
+/// \returns A reference to this scene state
+template <typename TEventFunction, typename TEvent, u64 MarkerCount>
+auto SceneState<TEventFunction, TEvent, MarkerCount>::operator=(SceneState&& rhs) -> SceneState& {
+	graph_ = std::move(rhs.graph_);
+	marked_sections_ = std::move(rhs.marked_sections_);
+	rebuild_dispatch_tables();
+	return *this;
+}
+
 /// \brief Register a node-local event
 /// \param type Type of outer event emitted
 /// \param name Name of the event to register
 /// \param event Event function that is stored to be invoked in dispatches
-template <typename TEventFunction, typename TEvent>
-void SceneState<TEventFunction, TEvent>::register_event(const outer_event_t& type,
-														const std::string& name,
-														event_t&& event) {
+template <typename TEventFunction, typename TEvent, u64 MarkerCount>
+void SceneState<TEventFunction, TEvent, MarkerCount>::register_event(const outer_event_t& type, const std::string& name, event_t&& event) {
+	if (dispatching()) {
+		deferred_changes_.emplace_back([type, name, fn = std::move(event)](SceneState& state) mutable { state.register_event(type, name, std::move(fn)); });
+		return;
+	}
+
 	auto& reged_events = marked_sections_[type].first;
 	reged_events[name] = std::move(event);
+	rebuild_dispatch_tables();
 }
 
 /// \brief Register a node-local event
 /// \param type Type of outer event emitted
 /// \param name Name of the event to register
 /// \param event Event function that is stored to be invoked in dispatches
-template <typename TEventFunction, typename TEvent>
-void SceneState<TEventFunction, TEvent>::register_event(const outer_event_t& type,
-														std::string&& name,
-														event_t&& event) {
+template <typename TEventFunction, typename TEvent, u64 MarkerCount>
+void SceneState<TEventFunction, TEvent, MarkerCount>::register_event(const outer_event_t& type, std::string&& name, event_t&& event) {
+	if (dispatching()) {
+		deferred_changes_.emplace_back([type, name = std::move(name), fn = std::move(event)](SceneState& state) mutable {
+			state.register_event(type, std::move(name), std::move(fn));
+		});
+		return;
+	}
+
 	auto& reged_events = marked_sections_[type].first;
 	reged_events[std::move(name)] = std::move(event);
+	rebuild_dispatch_tables();
 }
 
 /// \brief Register a global event
 /// \param type Type of outer event emitted
 /// \param name Name of the event to register
 /// \param event Event function that is stored to be invoked in dispatches
-template <typename TEventFunction, typename TEvent>
-void SceneState<TEventFunction, TEvent>::register_global_event(const outer_event_t& type,
-															   const std::string& name,
-															   event_t&& event) {
+template <typename TEventFunction, typename TEvent, u64 MarkerCount>
+void SceneState<TEventFunction, TEvent, MarkerCount>::register_global_event(const outer_event_t& type, const std::string& name, event_t&& event) {
+	if (dispatching()) {
+		deferred_changes_.emplace_back([type, name, fn = std::move(event)](SceneState& state) mutable { state.register_global_event(type, name, std::move(fn)); });
+		return;
+	}
+
 	auto& reged_events = marked_sections_[type].second;
 	reged_events[name] = std::move(event);
+	rebuild_dispatch_tables();
 }
 
 /// \brief Register a global event
 /// \param type Type of outer event emitted
 /// \param name Name of the event to register
 /// \param event Event function that is stored to be invoked in dispatches
-template <typename TEventFunction, typename TEvent>
-void SceneState<TEventFunction, TEvent>::register_global_event(const outer_event_t& type,
-															   std::string&& name,
-															   event_t&& event) {
+template <typename TEventFunction, typename TEvent, u64 MarkerCount>
+void SceneState<TEventFunction, TEvent, MarkerCount>::register_global_event(const outer_event_t& type, std::string&& name, event_t&& event) {
+	if (dispatching()) {
+		deferred_changes_.emplace_back([type, name = std::move(name), fn = std::move(event)](SceneState& state) mutable {
+			state.register_global_event(type, std::move(name), std::move(fn));
+		});
+		return;
+	}
+
 	auto& reged_events = marked_sections_[type].second;
 	reged_events[std::move(name)] = std::move(event);
+	rebuild_dispatch_tables();
 }
 
 /// \brief Unregisters a node-local event
 /// \param type Type of outer event emitted
 /// \param name Name of the event to unregister
-template <typename TEventFunction, typename TEvent>
-void SceneState<TEventFunction, TEvent>::unregister_event(const outer_event_t& type, const std::string& name) {
+template <typename TEventFunction, typename TEvent, u64 MarkerCount>
+void SceneState<TEventFunction, TEvent, MarkerCount>::unregister_event(const outer_event_t& type, const std::string& name) {
+	if (dispatching()) {
+		deferred_changes_.emplace_back([type, name](SceneState& state) { state.unregister_event(type, name); });
+		return;
+	}
+
 	marked_sections_[type].first.erase(name);
+	rebuild_dispatch_tables();
 }
 
 /// \brief Unregisters a node-local event
 /// \param type Type of outer event emitted
 /// \param name Name of the event to unregister
-template <typename TEventFunction, typename TEvent>
-void SceneState<TEventFunction, TEvent>::unregister_event(const outer_event_t& type, std::string&& name) {
+template <typename TEventFunction, typename TEvent, u64 MarkerCount>
+void SceneState<TEventFunction, TEvent, MarkerCount>::unregister_event(const outer_event_t& type, std::string&& name) {
+	if (dispatching()) {
+		deferred_changes_.emplace_back([type, name = std::move(name)](SceneState& state) mutable { state.unregister_event(type, std::move(name)); });
+		return;
+	}
+
 	marked_sections_[type].first.erase(std::move(name));
+	rebuild_dispatch_tables();
 }
 
 /// \brief Unregisters a global event
 /// \param type Type of outer event emitted
 /// \param name Name of the event to unregister
-template <typename TEventFunction, typename TEvent>
-void SceneState<TEventFunction, TEvent>::unregister_global_event(const outer_event_t& type, const std::string& name) {
+template <typename TEventFunction, typename TEvent, u64 MarkerCount>
+void SceneState<TEventFunction, TEvent, MarkerCount>::unregister_global_event(const outer_event_t& type, const std::string& name) {
+	if (dispatching()) {
+		deferred_changes_.emplace_back([type, name](SceneState& state) { state.unregister_global_event(type, name); });
+		return;
+	}
+
 	marked_sections_[type].second.erase(name);
+	rebuild_dispatch_tables();
 }
 
 /// \brief Unregisters a global event
 /// \param type Type of outer event emitted
 /// \param name Name of the event to unregister
-template <typename TEventFunction, typename TEvent>
-void SceneState<TEventFunction, TEvent>::unregister_global_event(const outer_event_t& type, std::string&& name) {
+template <typename TEventFunction, typename TEvent, u64 MarkerCount>
+void SceneState<TEventFunction, TEvent, MarkerCount>::unregister_global_event(const outer_event_t& type, std::string&& name) {
+	if (dispatching()) {
+		deferred_changes_.emplace_back([type, name = std::move(name)](SceneState& state) mutable { state.unregister_global_event(type, std::move(name)); });
+		return;
+	}
+
 	marked_sections_[type].second.erase(std::move(name));
+	rebuild_dispatch_tables();
 }
 
 /// \brief Gets the node-local event from the event map
@@ -150,8 +304,8 @@ void SceneState<TEventFunction, TEvent>::unregister_global_event(const outer_eve
 /// \param type Type of outer event emitted
 /// \param name Name of the event to register
 /// \returns The specified event
-template <typename TEventFunction, typename TEvent>
-auto SceneState<TEventFunction, TEvent>::get_event(const outer_event_t& type, const std::string& name) const
+template <typename TEventFunction, typename TEvent, u64 MarkerCount>
+auto SceneState<TEventFunction, TEvent, MarkerCount>::get_event(const outer_event_t& type, const std::string& name) const
   -> const event_t& {
 	return marked_sections_.at(type).first.at(name);
 }
@@ -161,8 +315,8 @@ auto SceneState<TEventFunction, TEvent>::get_event(const outer_event_t& type, co
 /// \param type Type of outer event emitted
 /// \param name Name of the event to register
 /// \returns The specified event
-template <typename TEventFunction, typename TEvent>
-auto SceneState<TEventFunction, TEvent>::get_event(const outer_event_t& type, std::string&& name) const
+template <typename TEventFunction, typename TEvent, u64 MarkerCount>
+auto SceneState<TEventFunction, TEvent, MarkerCount>::get_event(const outer_event_t& type, std::string&& name) const
   -> const event_t& {
 	return marked_sections_.at(type).first.at(std::move(name));
 }
@@ -172,8 +326,8 @@ auto SceneState<TEventFunction, TEvent>::get_event(const outer_event_t& type, st
 /// \param type Type of outer event emitted
 /// \param name Name of the event to register
 /// \returns The specified event
-template <typename TEventFunction, typename TEvent>
-auto SceneState<TEventFunction, TEvent>::get_global_event(const outer_event_t& type, const std::string& name) const
+template <typename TEventFunction, typename TEvent, u64 MarkerCount>
+auto SceneState<TEventFunction, TEvent, MarkerCount>::get_global_event(const outer_event_t& type, const std::string& name) const
   -> const event_t& {
 	return marked_sections_.at(type).second.at(name);
 }
@@ -183,38 +337,38 @@ auto SceneState<TEventFunction, TEvent>::get_global_event(const outer_event_t& t
 /// \param type Type of outer event emitted
 /// \param name Name of the event to register
 /// \returns The specified event
-template <typename TEventFunction, typename TEvent>
-auto SceneState<TEventFunction, TEvent>::get_global_event(const outer_event_t& type, std::string&& name) const
+template <typename TEventFunction, typename TEvent, u64 MarkerCount>
+auto SceneState<TEventFunction, TEvent, MarkerCount>::get_global_event(const outer_event_t& type, std::string&& name) const
   -> const event_t& {
 	return marked_sections_.at(type).second.at(std::move(name));
 }
 
 /// \brief Gets the \sa cui::SceneGraph
 /// \returns The \sa cui::SceneGraph
-template <typename TEventFunction, typename TEvent>
-auto SceneState<TEventFunction, TEvent>::graph() noexcept -> graph_t& {
+template <typename TEventFunction, typename TEvent, u64 MarkerCount>
+auto SceneState<TEventFunction, TEvent, MarkerCount>::graph() noexcept -> graph_t& {
 	return graph_;
 }
 
 /// \brief Gets the \sa cui::SceneGraph
 /// \returns The \sa cui::SceneGraph
-template <typename TEventFunction, typename TEvent>
-auto SceneState<TEventFunction, TEvent>::graph() const noexcept -> const graph_t& {
+template <typename TEventFunction, typename TEvent, u64 MarkerCount>
+auto SceneState<TEventFunction, TEvent, MarkerCount>::graph() const noexcept -> const graph_t& {
 	return graph_;
 }
 
 /// \brief Gets the event map
 /// \returns The event map
-template <typename TEventFunction, typename TEvent>
-auto SceneState<TEventFunction, TEvent>::marked_sections() const noexcept -> const event_marker_map_t& {
+template <typename TEventFunction, typename TEvent, u64 MarkerCount>
+auto SceneState<TEventFunction, TEvent, MarkerCount>::marked_sections() const noexcept -> const event_marker_map_t& {
 	return marked_sections_;
 }
 
 /// \brief Gets the list of registered node-local events on a specified outer event type
 /// \details May throw if no such outer event type is registered yet
 /// \returns The events marked on the outer event type
-template <typename TEventFunction, typename TEvent>
-auto SceneState<TEventFunction, TEvent>::registered_events(const outer_event_t& event_type) const
+template <typename TEventFunction, typename TEvent, u64 MarkerCount>
+auto SceneState<TEventFunction, TEvent, MarkerCount>::registered_events(const outer_event_t& event_type) const
   -> const event_map_t& {
 	return marked_sections_.at(event_type).first;
 }
@@ -222,12 +376,82 @@ auto SceneState<TEventFunction, TEvent>::registered_events(const outer_event_t&
 /// \brief Gets the list of registered global events on a specified outer event type
 /// \details May throw if no such outer event type is registered yet
 /// \returns The events marked on the outer event type
-template <typename TEventFunction, typename TEvent>
-auto SceneState<TEventFunction, TEvent>::registered_global_events(const outer_event_t& event_type) const
+template <typename TEventFunction, typename TEvent, u64 MarkerCount>
+auto SceneState<TEventFunction, TEvent, MarkerCount>::registered_global_events(const outer_event_t& event_type) const
   -> const event_map_t& {
 	return marked_sections_.at(event_type).second;
 }
 
+/// \brief Gets the compiled dispatch table of an outer event type
+/// \details Outer event types outside of the marker range get an empty table
+/// \param type Type of outer event emitted
+/// \returns The resolved global and node-local handlers for the outer event type
+template <typename TEventFunction, typename TEvent, u64 MarkerCount>
+auto SceneState<TEventFunction, TEvent, MarkerCount>::dispatch_table(const outer_event_t& type) const noexcept -> const DispatchTable& {
+	static const DispatchTable empty_table{};
+	const auto idx = static_cast<u64>(type);
+	if (idx >= MarkerCount) return empty_table;
+
+	return dispatch_tables_[idx];
+}
+
+/// \brief Checks whether any global or node-local event is registered on an outer event type
+/// \param type Type of outer event emitted
+/// \returns A boolean indicating whether the outer event type needs processing
+template <typename TEventFunction, typename TEvent, u64 MarkerCount>
+bool SceneState<TEventFunction, TEvent, MarkerCount>::has_subscribers(const outer_event_t& type) const noexcept {
+	return !dispatch_table(type).empty();
+}
+
+/// \brief Gets the outer event types that have no registered events
+/// \returns The outer event types whose processing can be skipped
+template <typename TEventFunction, typename TEvent, u64 MarkerCount>
+auto SceneState<TEventFunction, TEvent, MarkerCount>::unsubscribed_markers() const -> std::vector<outer_event_t> {
+	std::vector<outer_event_t> markers;
+	for (u64 i = 0; i < MarkerCount; ++i) {
+		if (dispatch_tables_[i].empty()) markers.push_back(static_cast<outer_event_t>(i));
+	}
+	return markers;
+}
+
+/// \brief Closes a dispatch scope
+/// \details The outermost scope applies the registration changes queued by handlers in the order they were made
+template <typename TEventFunction, typename TEvent, u64 MarkerCount>
+void SceneState<TEventFunction, TEvent, MarkerCount>::end_dispatch() {
+	if (--dispatch_depth_ > 0 || deferred_changes_.empty()) return;
+
+	auto changes = std::move(deferred_changes_);
+	deferred_changes_.clear();
+	for (auto& change : changes) change(*this);
+}
+
+/// \brief Recompiles the event marker map into the per-marker dispatch tables
+/// \details All tables are rebuilt since a rehash of the event marker map may relocate every stored
+/// name and event function
+template <typename TEventFunction, typename TEvent, u64 MarkerCount>
+void SceneState<TEventFunction, TEvent, MarkerCount>::rebuild_dispatch_tables() {
+	for (auto& table : dispatch_tables_) {
+		table.node_events.clear();
+		table.global_events.clear();
+	}
+
+	for (auto it = marked_sections_.begin(); it != marked_sections_.end(); ++it) {
+		const auto idx = static_cast<u64>(it->first);
+		if (idx >= MarkerCount) continue;
+
+		auto& table = dispatch_tables_[idx];
+		const auto& [node_events, global_events] = it->second;
+		table.node_events.reserve(node_events.size());
+		table.global_events.reserve(global_events.size());
+		for (auto e_it = node_events.begin(); e_it != node_events.end(); ++e_it) {
+			table.node_events.push_back(Handler{&e_it->first, &e_it->second});
+		}
+		for (auto e_it = global_events.begin(); e_it != global_events.end(); ++e_it) {
+			table.global_events.push_back(Handler{&e_it->first, &e_it->second});
+		}
+	}
+}
+
 }	 // namespace cui
 
 #endif	  // CUI_SCENE_STATE_HPP
\ No newline at end of file
@@ -16,26 +16,33 @@ struct Empty
 
 /// \brief Variant container containing CUI data types
 /// \details May throw on invalid type access
-/// Union members are pointers in order to result in less memory being stored in the instance itself
+/// Scalar, color and vector members are stored inline so assigning them never allocates, only strings live on
+/// the heap in order to keep the instance itself small
 class ValueData
 {
 public:
-	ValueData() : active_(DataTypes::None), none_(nullptr) {}
-	ValueData(const Color& color) : active_(DataTypes::Color), rgba_(new Color(color)) {}
-	ValueData(const float val) : active_(DataTypes::Float), float_value_(new float(val)) {}
-	ValueData(const int val) : active_(DataTypes::Int), integer_value_(new int(val)) {}
-	ValueData(const Vec2f& v2) : active_(DataTypes::Vec2), vec2_(new Vec2f(v2)) {}
-	ValueData(const Vec3f& v3) : active_(DataTypes::Vec3), vec3_(new Vec3f(v3)) {}
-	ValueData(const Vec4f& v4) : active_(DataTypes::Vec4), vec4_(new Vec4f(v4)) {}
-	ValueData(const Instruction& instr) : active_(DataTypes::Instruction), instruction_(new Instruction(instr)) {}
+	ValueData() : active_(DataTypes::None), none_() {}
+	ValueData(const Color& color) : active_(DataTypes::Color), rgba_(color) {}
+	ValueData(const float val) : active_(DataTypes::Float), float_value_(val) {}
+	ValueData(const int val) : active_(DataTypes::Int), integer_value_(val) {}
+	ValueData(const Vec2f& v2) : active_(DataTypes::Vec2), vec2_(v2) {}
+	ValueData(const Vec3f& v3) : active_(DataTypes::Vec3), vec3_(v3) {}
+	ValueData(const Vec4f& v4) : active_(DataTypes::Vec4), vec4_(v4) {}
+	ValueData(const Instruction& instr) : active_(DataTypes::Instruction), instruction_(instr) {}
 	ValueData(const std::string& instr) : active_(DataTypes::String), string_(new std::string(instr)) {}
 
 	ValueData(const ValueData& other);
 
+	ValueData(ValueData&& other) noexcept;
+
 	ValueData(const ct::ValueData& other);
 
+	~ValueData();
+
 	ValueData& operator=(const ValueData& a);
 
+	ValueData& operator=(ValueData&& a) noexcept;
+
 	ValueData& operator=(const ct::ValueData& a);
 
 	ValueData& operator=(const Color& color);
@@ -107,21 +114,29 @@ public:
 
 	[[nodiscard]] auto active() const noexcept -> DataTypes;
 
+	[[nodiscard]] bool operator==(const ValueData& rhs) const noexcept;
+
+	[[nodiscard]] bool operator!=(const ValueData& rhs) const noexcept {
+		return !operator==(rhs);
+	}
+
 private:
+	void copy_inline(const ValueData& other) noexcept;
+
 	void delete_current_active();
 
 	DataTypes active_;
 
 	union
 	{
-		Empty* none_;
-		Color* rgba_;
-		float* float_value_;
-		int* integer_value_;
-		Vec2f* vec2_;
-		Vec3f* vec3_;
-		Vec4f* vec4_;
-		Instruction* instruction_;
+		Empty none_;
+		Color rgba_;
+		float float_value_;
+		int integer_value_;
+		Vec2f vec2_;
+		Vec3f vec3_;
+		Vec4f vec4_;
+		Instruction instruction_;
 		std::string* string_;
 	};
 };
@@ -129,171 +144,89 @@ private:
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// \brief Copy constructs the \sa cui::ValueData with \sa cui::ValueData
-ValueData::ValueData(const ValueData& other) {
-	active_ = other.active_;
-	switch (other.active_) {
-		case DataTypes::Color: {
-			rgba_ = new Color(other.rgba());
-			break;
-		}
-		case DataTypes::Float: {
-			float_value_ = new float(other.float_value());
-			break;
-		}
-		case DataTypes::Int: {
-			integer_value_ = new int(other.integer_value());
-			break;
-		}
-		case DataTypes::Vec2: {
-			vec2_ = new Vec2f(other.vec2());
-			break;
-		}
-		case DataTypes::Vec3: {
-			vec3_ = new Vec3f(other.vec3());
-			break;
-		}
-		case DataTypes::Vec4: {
-			vec4_ = new Vec4f(other.vec4());
-			break;
-		}
-		case DataTypes::Instruction: {
-			instruction_ = new Instruction(other.instruction());
-			break;
-		}
-		case DataTypes::String: {
-			string_ = new std::string(other.string());
-			break;
-		}
-		default: {
-			break;
-		}
+ValueData::ValueData(const ValueData& other) : active_(DataTypes::None), none_() {
+	if (other.active_ == DataTypes::String) {
+		active_ = DataTypes::String;
+		string_ = new std::string(other.string());
+		return;
 	}
+	this->copy_inline(other);
 }
 
-/// \brief Copy constructs the \sa cui::ValueData with \sa cui::ct::ValueData
-ValueData::ValueData(const ct::ValueData& other) {
-	active_ = other.active();
-	switch (active_) {
-		case DataTypes::Color: {
-			rgba_ = new Color(other.rgba());
-			break;
-		}
-		case DataTypes::Float: {
-			float_value_ = new float(other.float_value());
-			break;
-		}
-		case DataTypes::Int: {
-			integer_value_ = new int(other.integer_value());
-			break;
-		}
-		case DataTypes::Vec2: {
-			vec2_ = new Vec2f(other.vec2());
-			break;
-		}
-		case DataTypes::Vec3: {
-			vec3_ = new Vec3f(other.vec3());
-			break;
-		}
-		case DataTypes::Vec4: {
-			vec4_ = new Vec4f(other.vec4());
-			break;
-		}
-		case DataTypes::Instruction: {
-			instruction_ = new Instruction(other.instruction());
-			break;
-		}
-		case DataTypes::String: {
-			string_ = new std::string(other.string().begin(), other.string().end());
-			break;
-		}
-		default: {
-			// Do nothing
-			break;
-		}
+/// \brief Move constructs the \sa cui::ValueData, taking over the string of the other value if it holds one
+ValueData::ValueData(ValueData&& other) noexcept : active_(DataTypes::None), none_() {
+	this->copy_inline(other);
+	if (other.active_ == DataTypes::String) {
+		active_ = DataTypes::String;
+		string_ = other.string_;
+		other.active_ = DataTypes::None;
 	}
 }
 
+/// \brief Copy constructs the \sa cui::ValueData with \sa cui::ct::ValueData
+ValueData::ValueData(const ct::ValueData& other) : active_(DataTypes::None), none_() {
+	this->operator=(other);
+}
+
+/// \brief Frees the string if one is held
+ValueData::~ValueData() {
+	this->delete_current_active();
+}
+
 /// \brief Copy assigns the \sa cui::ValueData with \sa cui::ValueData
 ValueData& ValueData::operator=(const ValueData& a) {
+	if (this == &a) return (*this);
+	if (a.active_ == DataTypes::String) return this->operator=(a.string());
+
 	this->delete_current_active();
-	active_ = a.active_;
-	switch (a.active_) {
-		case DataTypes::Color: {
-			rgba_ = new Color(a.rgba());
-			return (*this);
-		}
-		case DataTypes::Float: {
-			float_value_ = new float(a.float_value());
-			return (*this);
-		}
-		case DataTypes::Int: {
-			integer_value_ = new int(a.integer_value());
-			return (*this);
-		}
-		case DataTypes::Vec2: {
-			vec2_ = new Vec2f(a.vec2());
-			return (*this);
-		}
-		case DataTypes::Vec3: {
-			vec3_ = new Vec3f(a.vec3());
-			return (*this);
-		}
-		case DataTypes::Vec4: {
-			vec4_ = new Vec4f(a.vec4());
-			return (*this);
-		}
-		case DataTypes::Instruction: {
-			instruction_ = new Instruction(a.instruction());
-			return (*this);
-		}
-		case DataTypes::String: {
-			string_ = new std::string(a.string());
-			return (*this);
-		}
-		default: {
-			return (*this);
-		}
+	this->copy_inline(a);
+	return (*this);
+}
+
+/// \brief Move assigns the \sa cui::ValueData, taking over the string of the other value if it holds one
+ValueData& ValueData::operator=(ValueData&& a) noexcept {
+	if (this == &a) return (*this);
+
+	this->delete_current_active();
+	this->copy_inline(a);
+	if (a.active_ == DataTypes::String) {
+		active_ = DataTypes::String;
+		string_ = a.string_;
+		a.active_ = DataTypes::None;
 	}
+	return (*this);
 }
 
 /// \brief Copy assigns the \sa cui::ValueData with \sa cui::ct::ValueData
 ValueData& ValueData::operator=(const ct::ValueData& a) {
-	this->delete_current_active();
-	active_ = a.active();
-	switch (active_) {
+	switch (a.active()) {
 		case DataTypes::Color: {
-			rgba_ = new Color(a.rgba());
-			return (*this);
+			return this->operator=(Color(a.rgba()));
 		}
 		case DataTypes::Float: {
-			float_value_ = new float(a.float_value());
-			return (*this);
+			return this->operator=(a.float_value());
 		}
 		case DataTypes::Int: {
-			integer_value_ = new int(a.integer_value());
-			return (*this);
+			return this->operator=(a.integer_value());
 		}
 		case DataTypes::Vec2: {
-			vec2_ = new Vec2f(a.vec2());
-			return (*this);
+			return this->operator=(Vec2f(a.vec2()));
 		}
 		case DataTypes::Vec3: {
-			vec3_ = new Vec3f(a.vec3());
-			return (*this);
+			return this->operator=(Vec3f(a.vec3()));
 		}
 		case DataTypes::Vec4: {
-			vec4_ = new Vec4f(a.vec4());
-			return (*this);
+			return this->operator=(Vec4f(a.vec4()));
 		}
 		case DataTypes::Instruction: {
-			instruction_ = new Instruction(a.instruction());
-			return (*this);
+			return this->operator=(Instruction(a.instruction()));
 		}
 		case DataTypes::String: {
-			string_ = new std::string(a.string().begin(), a.string().end());
-			return (*this);
+			return this->operator=(std::string(a.string().begin(), a.string().end()));
 		}
 		default: {
+			this->delete_current_active();
+			active_ = DataTypes::None;
 			return (*this);
 		}
 	}
@@ -305,7 +238,7 @@ ValueData& ValueData::operator=(const ct::ValueData& a) {
 ValueData& ValueData::operator=(const Color& color) {
 	this->delete_current_active();
 	active_ = DataTypes::Color;
-	rgba_ = new Color(color);
+	rgba_ = color;
 	return (*this);
 }
 
@@ -315,7 +248,7 @@ ValueData& ValueData::operator=(const Color& color) {
 ValueData& ValueData::operator=(const float val) {
 	this->delete_current_active();
 	active_ = DataTypes::Float;
-	float_value_ = new float(val);
+	float_value_ = val;
 	return (*this);
 }
 
@@ -325,7 +258,7 @@ ValueData& ValueData::operator=(const float val) {
 ValueData& ValueData::operator=(const int val) {
 	this->delete_current_active();
 	active_ = DataTypes::Int;
-	integer_value_ = new int(val);
+	integer_value_ = val;
 	return (*this);
 }
 
@@ -335,7 +268,7 @@ ValueData& ValueData::operator=(const int val) {
 ValueData& ValueData::operator=(const Vec2f& p_vec2) {
 	this->delete_current_active();
 	active_ = DataTypes::Vec2;
-	vec2_ = new Vec2f(p_vec2);
+	vec2_ = p_vec2;
 	return (*this);
 }
 
@@ -345,7 +278,7 @@ ValueData& ValueData::operator=(const Vec2f& p_vec2) {
 ValueData& ValueData::operator=(const Vec3f& p_vec3) {
 	this->delete_current_active();
 	active_ = DataTypes::Vec3;
-	vec3_ = new Vec3f(p_vec3);
+	vec3_ = p_vec3;
 	return (*this);
 }
 
@@ -355,7 +288,7 @@ ValueData& ValueData::operator=(const Vec3f& p_vec3) {
 ValueData& ValueData::operator=(const Vec4f& p_vec4) {
 	this->delete_current_active();
 	active_ = DataTypes::Vec4;
-	vec4_ = new Vec4f(p_vec4);
+	vec4_ = p_vec4;
 	return (*this);
 }
 
@@ -365,7 +298,7 @@ ValueData& ValueData::operator=(const Vec4f& p_vec4) {
 ValueData& ValueData::operator=(const Instruction& instr) {
 	this->delete_current_active();
 	active_ = DataTypes::Instruction;
-	instruction_ = new Instruction(instr);
+	instruction_ = instr;
 	return (*this);
 }
 
@@ -373,9 +306,16 @@ ValueData& ValueData::operator=(const Instruction& instr) {
 /// \param str The string to be assigned
 /// \returns The instance of \sa cui::ValueData that was assigned to
 ValueData& ValueData::operator=(const std::string& str) {
+	if (active_ == DataTypes::String) {
+		*string_ = str;
+		return (*this);
+	}
+
+	// Allocate before switching, a throwing allocation leaves the current value intact
+	auto* const string = new std::string(str);
 	this->delete_current_active();
 	active_ = DataTypes::String;
-	string_ = new std::string(str);
+	string_ = string;
 	return (*this);
 }
 
@@ -440,85 +380,85 @@ ValueData& ValueData::operator=(const std::string& str) {
 /// \brief Gets a mutable rgba value or throws in case of an invalid variant member access
 /// \returns The mutable RGBA color value
 [[nodiscard]] auto ValueData::rgba() noexcept -> Color& {
-	return *rgba_;
+	return rgba_;
 }
 
 /// \brief Gets an immutable rgba value or throws in case of an invalid variant member access
 /// \returns The immutable RGBA value
 [[nodiscard]] auto ValueData::rgba() const noexcept -> const Color& {
-	return *rgba_;
+	return rgba_;
 }
 
 /// \brief Gets a mutable float value or throws in case of an invalid variant member access
 /// \returns The mutable float value
 [[nodiscard]] auto ValueData::float_value() noexcept -> float& {
-	return *float_value_;
+	return float_value_;
 }
 
 /// \brief Gets an immutable float value or throws in case of an invalid variant member access
 /// \returns The immutable float value
 [[nodiscard]] auto ValueData::float_value() const noexcept -> float {
-	return *float_value_;
+	return float_value_;
 }
 
 /// \brief Gets a mutable int value or throws in case of an invalid variant member access
 /// \returns The mutable int value
 [[nodiscard]] auto ValueData::integer_value() noexcept -> int& {
-	return *integer_value_;
+	return integer_value_;
 }
 
 /// \brief Gets an immutable int value or throws in case of an invalid variant member access
 /// \returns The immutable int value
 [[nodiscard]] auto ValueData::integer_value() const noexcept -> int {
-	return *integer_value_;
+	return integer_value_;
 }
 
 /// \brief Gets a mutable \sa cui::Vec2f value or throws in case of an invalid variant member access
 /// \returns The mutable \sa cui::Vec2f value
 [[nodiscard]] auto ValueData::vec2() noexcept -> Vec2f& {
-	return *vec2_;
+	return vec2_;
 }
 
 /// \brief Gets an immutable \sa cui::Vec2f value or throws in case of an invalid variant member access
 /// \returns The immutable \sa cui::Vec2f value
 [[nodiscard]] auto ValueData::vec2() const noexcept -> const Vec2f& {
-	return *vec2_;
+	return vec2_;
 }
 
 /// \brief Gets a mutable \sa cui::Vec3f value or throws in case of an invalid variant member access
 /// \returns The mutable \sa cui::Vec3f value
 [[nodiscard]] auto ValueData::vec3() noexcept -> Vec3f& {
-	return *vec3_;
+	return vec3_;
 }
 
 /// \brief Gets an immutable \sa cui::Vec3f value or throws in case of an invalid variant member access
 /// \returns The immutable \sa cui::Vec3f value
 [[nodiscard]] auto ValueData::vec3() const noexcept -> const Vec3f& {
-	return *vec3_;
+	return vec3_;
 }
 
 /// \brief Gets a mutable \sa cui::Vec4f value or throws in case of an invalid variant member access
 /// \returns The mutable \sa cui::Vec4f value
 [[nodiscard]] auto ValueData::vec4() noexcept -> Vec4f& {
-	return *vec4_;
+	return vec4_;
 }
 
 /// \brief Gets an immutable \sa cui::Vec4f value or throws in case of an invalid variant member access
 /// \returns The immutable \sa cui::Vec4f value
 [[nodiscard]] auto ValueData::vec4() const noexcept -> const Vec4f& {
-	return *vec4_;
+	return vec4_;
 }
 
 /// \brief Gets a mutable \sa cui::Instruction value or throws in case of an invalid variant member access
 /// \returns The mutable \sa cui::Instruction value
 [[nodiscard]] auto ValueData::instruction() noexcept -> Instruction& {
-	return *instruction_;
+	return instruction_;
 }
 
 /// \brief Gets an immutable \sa cui::Instruction value or throws in case of an invalid variant member access
 /// \returns The immutable \sa cui::Instruction  value
 [[nodiscard]] auto ValueData::instruction() const noexcept -> const Instruction& {
-	return *instruction_;
+	return instruction_;
 }
 
 /// \brief Gets a mutable \sa std::string value or throws in case of an invalid variant member access
@@ -539,47 +479,87 @@ ValueData& ValueData::operator=(const std::string& str) {
 	return active_;
 }
 
-/// \brief Deletes the current active variant member
-/// \details Used when assigning a new value
-void ValueData::delete_current_active() {
+/// \brief Compares the active member and its value
+/// \returns Boolean indicating whether both values hold the same member with the same value
+[[nodiscard]] bool ValueData::operator==(const ValueData& rhs) const noexcept {
+	if (active_ != rhs.active_) return false;
 	switch (active_) {
 		case DataTypes::Color: {
-			delete rgba_;
+			return rgba_.data() == rhs.rgba_.data();
+		}
+		case DataTypes::Float: {
+			return float_value_ == rhs.float_value_;
+		}
+		case DataTypes::Int: {
+			return integer_value_ == rhs.integer_value_;
+		}
+		case DataTypes::Vec2: {
+			return vec2_ == rhs.vec2_;
+		}
+		case DataTypes::Vec3: {
+			return vec3_ == rhs.vec3_;
+		}
+		case DataTypes::Vec4: {
+			return vec4_ == rhs.vec4_;
+		}
+		case DataTypes::Instruction: {
+			return instruction_ == rhs.instruction_;
+		}
+		case DataTypes::String: {
+			return *string_ == *rhs.string_;
+		}
+		default: {
+			return true;
+		}
+	}
+}
+
+/// \brief Copies an inline variant member, a string is left to the caller
+void ValueData::copy_inline(const ValueData& other) noexcept {
+	switch (other.active_) {
+		case DataTypes::Color: {
+			rgba_ = other.rgba_;
 			break;
 		}
 		case DataTypes::Float: {
-			delete float_value_;
+			float_value_ = other.float_value_;
 			break;
 		}
 		case DataTypes::Int: {
-			delete integer_value_;
+			integer_value_ = other.integer_value_;
 			break;
 		}
 		case DataTypes::Vec2: {
-			delete vec2_;
+			vec2_ = other.vec2_;
 			break;
 		}
 		case DataTypes::Vec3: {
-			delete vec3_;
+			vec3_ = other.vec3_;
 			break;
 		}
 		case DataTypes::Vec4: {
-			delete vec4_;
+			vec4_ = other.vec4_;
 			break;
 		}
 		case DataTypes::Instruction: {
-			delete instruction_;
-			break;
-		}
-		case DataTypes::String: {
-			delete string_;
+			instruction_ = other.instruction_;
 			break;
 		}
 		default: {
-			// Do nothing
-			break;
+			active_ = DataTypes::None;
+			return;
 		}
 	}
+	active_ = other.active_;
+}
+
+/// \brief Deletes the current active variant member
+/// \details Used when assigning a new value, only strings own memory
+void ValueData::delete_current_active() {
+	if (active_ == DataTypes::String) {
+		delete string_;
+		active_ = DataTypes::None;
+	}
 }
 
 }	 // namespace cui
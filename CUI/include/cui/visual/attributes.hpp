@@ -49,6 +49,8 @@ public:
 
 	[[nodiscard]] auto text_position() const noexcept -> const ValueData&;
 
+	[[nodiscard]] bool operator==(const Attributes& rhs) const noexcept;
+
 protected:
 	ValueData x_;
 	ValueData y_;
@@ -186,6 +188,13 @@ auto Attributes::text_position() const noexcept -> const ValueData& {
 	return text_position_;
 }
 
+/// \brief Compares every attribute
+/// \returns Boolean indicating whether all attributes are equal
+bool Attributes::operator==(const Attributes& rhs) const noexcept {
+	return x_ == rhs.x_ && y_ == rhs.y_ && width_ == rhs.width_ && height_ == rhs.height_ && background_ == rhs.background_ &&
+		   text_color_ == rhs.text_color_ && font_size_ == rhs.font_size_ && font_ == rhs.font_ && text_position_ == rhs.text_position_;
+}
+
 }	 // namespace cui
 
 #endif	  // CUI_ATTRIBUTES_HPP
\ No newline at end of file
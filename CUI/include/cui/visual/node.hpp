@@ -2,7 +2,9 @@
 #define CUI_NODE_HPP
 
 #include <functional>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <compile_time/string/string_view.hpp>
 #include <tsl/hopscotch_map.h>
@@ -12,13 +14,17 @@
 namespace cui {
 
 /// \brief Main GUI component
-/// \details Dictates how the GUI is visually structured
+/// \details Dictates how the GUI is visually structured. Copies share the default and event schematics
+/// copy-on-write, so instancing a subtree only copies names, texts and event sets. The mutable schematic
+/// getters give the node its own copy first when the schematics are shared, the immutable ones never copy.
+/// The active schematic is per node and switched through \sa Node::set_active(), which never copies.
+/// References obtained from a mutable getter must not be kept across copies of the node
 class Node
 {
 public:
 	using schematic_map_t = tsl::hopscotch_map<std::string, Schematic>;
 
-	Node() noexcept;
+	Node();
 
 	Node(const std::string& p_name, const std::string& p_text);
 
@@ -30,23 +36,25 @@ public:
 
 	Node(const Node& rhs);
 
-	Node(Node&& rhs);
+	Node(Node&& rhs) noexcept;
 
 	auto operator=(const Node& rhs) -> Node&;
 
-	auto operator=(Node&& rhs) -> Node&;
+	auto operator=(Node&& rhs) noexcept -> Node&;
 
-	[[nodiscard]] auto default_schematic() noexcept -> Schematic&;
+	[[nodiscard]] auto default_schematic() -> Schematic&;
 
 	[[nodiscard]] auto default_schematic() const noexcept -> const Schematic&;
 
-	[[nodiscard]] auto event_schematics() noexcept -> schematic_map_t&;
+	[[nodiscard]] auto event_schematics() -> schematic_map_t&;
 
 	[[nodiscard]] auto event_schematics() const noexcept -> const schematic_map_t&;
 
-	[[nodiscard]] auto active_schematic() noexcept -> std::reference_wrapper<Schematic>&;
+	[[nodiscard]] auto active_schematic() -> std::reference_wrapper<Schematic>&;
 
-	[[nodiscard]] auto active_schematic() const noexcept -> const std::reference_wrapper<Schematic>&;
+	[[nodiscard]] auto active_schematic() const noexcept -> const Schematic&;
+
+	bool set_active(const std::string& name);
 
 	[[nodiscard]] auto name() noexcept -> std::string&;
 
@@ -64,13 +72,46 @@ public:
 
 	void detach_event(const std::string& name);
 
+	[[nodiscard]] auto delegated_events() noexcept -> tsl::hopscotch_set<std::string>&;
+
+	[[nodiscard]] auto delegated_events() const noexcept -> const tsl::hopscotch_set<std::string>&;
+
+	void delegate_event(const std::string& name);
+
+	void undelegate_event(const std::string& name);
+
+	[[nodiscard]] auto style_classes() noexcept -> std::vector<std::string>&;
+
+	[[nodiscard]] auto style_classes() const noexcept -> const std::vector<std::string>&;
+
+	[[nodiscard]] bool shares_schematics() const noexcept {
+		return schematics_.use_count() > 1;
+	}
+
+	[[nodiscard]] bool same_schematics(const Node& rhs) const;
+
+	void share_schematics(const Node& rhs);
+
 private:
-	Schematic default_schematic_;
-	schematic_map_t event_schematics_;
+	struct Schematics
+	{
+		Schematic default_schematic;
+		schematic_map_t event_schematics;
+	};
+
+	void detach();
+
+	[[nodiscard]] static auto empty_schematics() noexcept -> const std::shared_ptr<Schematics>&;
+
+	void release_schematics() noexcept;
+
+	std::shared_ptr<Schematics> schematics_;
 	std::reference_wrapper<Schematic> active_;
 	std::string name_;
 	std::string text_;
 	tsl::hopscotch_set<std::string> attached_events_;
+	tsl::hopscotch_set<std::string> delegated_events_;
+	std::vector<std::string> style_classes_;
 };
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -78,111 +119,144 @@ private:
 /// \brief Constructs the root node
 /// \details Schematics are default constructed, active schematic is set to the default schematic,
 /// name is "root" and text is empty
-Node::Node() noexcept : default_schematic_(), event_schematics_(), active_(std::ref(default_schematic_)), name_("root"), text_("") {}
+Node::Node()
+	: schematics_(std::make_shared<Schematics>()), active_(std::ref(schematics_->default_schematic)), name_("root"), text_("") {}
 
 /// \brief Constructs the node
 /// \details Schematics are default constructed and active schematic is set to the default schematic
 /// \param p_name The name of the node
 /// \param p_text The text of the node
 Node::Node(const std::string& p_name, const std::string& p_text)
-	: default_schematic_(), event_schematics_(), active_(std::ref(default_schematic_)), name_(p_name), text_(p_text) {}
+	: schematics_(std::make_shared<Schematics>()), active_(std::ref(schematics_->default_schematic)), name_(p_name), text_(p_text) {}
 
 /// \brief Constructs the node
 /// \details Schematics are default constructed and active schematic is set to the default schematic
 /// \param p_name The name of the node
 /// \param p_text The text of the node
 Node::Node(const std::string& p_name, const ct::StringView p_text)
-	: default_schematic_(), event_schematics_(), active_(std::ref(default_schematic_)), name_(p_name), text_(p_text.begin(), p_text.end()) {}
+	: schematics_(std::make_shared<Schematics>()), active_(std::ref(schematics_->default_schematic)), name_(p_name), text_(p_text.begin(), p_text.end()) {}
 
 /// \brief Constructs the node
 /// \details Schematics are default constructed and active schematic is set to the default schematic
 /// \param p_name The name of the node
 /// \param p_text The text of the node
 Node::Node(const ct::StringView p_name, const std::string& p_text)
-	: default_schematic_(), event_schematics_(), active_(std::ref(default_schematic_)), name_(p_name.begin(), p_name.end()), text_(p_text) {}
+	: schematics_(std::make_shared<Schematics>()), active_(std::ref(schematics_->default_schematic)), name_(p_name.begin(), p_name.end()), text_(p_text) {}
 
 /// \brief Constructs the node
 /// \details Schematics are default constructed and active schematic is set to the default schematic
 /// \param p_name The name of the node
 /// \param p_text The text of the node
 Node::Node(const ct::StringView p_name, const ct::StringView p_text)
-	: default_schematic_(), event_schematics_(), active_(std::ref(default_schematic_)), name_(p_name.begin(), p_name.end()),
+	: schematics_(std::make_shared<Schematics>()), active_(std::ref(schematics_->default_schematic)), name_(p_name.begin(), p_name.end()),
 	  text_(p_text.begin(), p_text.end()) {}
 
 /// \brief Copy constructs the node
-/// \details Reassigns the active schematic to the default schematic
+/// \details Shares the schematics and the active schematic with the copied node
 Node::Node(const Node& rhs)
-	: default_schematic_(rhs.default_schematic_), event_schematics_(rhs.event_schematics_), active_(std::ref(default_schematic_)), name_(rhs.name_),
-	  text_(rhs.text_), attached_events_(rhs.attached_events_) {}
-
-/// \brief Copy constructs the node
-/// \details Reassigns the active schematic to the default schematic
-Node::Node(Node&& rhs)
-	: default_schematic_(std::move(rhs.default_schematic_)), event_schematics_(std::move(rhs.event_schematics_)), active_(std::ref(default_schematic_)),
-	  name_(std::move(rhs.name_)), text_(std::move(rhs.text_)), attached_events_(std::move(rhs.attached_events_)) {}
+	: schematics_(rhs.schematics_), active_(rhs.active_), name_(rhs.name_), text_(rhs.text_),
+	  attached_events_(rhs.attached_events_), delegated_events_(rhs.delegated_events_), style_classes_(rhs.style_classes_) {}
+
+/// \brief Move constructs the node
+/// \details Takes over the schematics and the active schematic, so schematics owned by the moved from node
+/// stay owned by a single node. The moved from node stays usable with empty schematics
+Node::Node(Node&& rhs) noexcept
+	: schematics_(std::move(rhs.schematics_)), active_(rhs.active_), name_(std::move(rhs.name_)), text_(std::move(rhs.text_)),
+	  attached_events_(std::move(rhs.attached_events_)), delegated_events_(std::move(rhs.delegated_events_)),
+	  style_classes_(std::move(rhs.style_classes_)) {
+	rhs.release_schematics();
+}
 
 /// \brief Copy assigns the node
-/// \details Reassigns the active schematic to the default schematic
+/// \details Shares the schematics and the active schematic of the right side node
 /// \param rhs Right side node
 /// \returns A reference to this node
 auto Node::operator=(const Node& rhs) -> Node& {
-	default_schematic_ = rhs.default_schematic_;
-	event_schematics_ = rhs.event_schematics_;
-	active_ = default_schematic_;
+	schematics_ = rhs.schematics_;
+	active_ = rhs.active_;
 	name_ = rhs.name_;
 	text_ = rhs.text_;
 	attached_events_ = rhs.attached_events_;
+	delegated_events_ = rhs.delegated_events_;
+	style_classes_ = rhs.style_classes_;
 	return *this;
 }
 
-/// \brief Copy assigns the node
-/// \details Reassigns the active schematic to the default schematic
+/// \brief Move assigns the node
+/// \details Takes over the schematics and the active schematic of the moved from node, which stays usable with
+/// empty schematics
 /// \param rhs Right side node
 /// \returns A reference to this node
-auto Node::operator=(Node&& rhs) -> Node& {
-	default_schematic_ = std::move(rhs.default_schematic_);
-	event_schematics_ = std::move(rhs.event_schematics_);
-	active_ = default_schematic_;
+auto Node::operator=(Node&& rhs) noexcept -> Node& {
+	if (this == &rhs) return *this;
+
+	schematics_ = std::move(rhs.schematics_);
+	active_ = rhs.active_;
+	rhs.release_schematics();
 	name_ = std::move(rhs.name_);
 	text_ = std::move(rhs.text_);
 	attached_events_ = std::move(rhs.attached_events_);
+	delegated_events_ = std::move(rhs.delegated_events_);
+	style_classes_ = std::move(rhs.style_classes_);
 	return *this;
 }
 
 /// \brief Gets a mutable default schematic
+/// \details Copies the schematics first if they are shared
 /// \returns The mutable default schematic
-auto Node::default_schematic() noexcept -> Schematic& {
-	return default_schematic_;
+auto Node::default_schematic() -> Schematic& {
+	detach();
+	return schematics_->default_schematic;
 }
 
 /// \brief Gets an immutable default schematic
 /// \returns The immutable default schematic
 auto Node::default_schematic() const noexcept -> const Schematic& {
-	return default_schematic_;
+	return schematics_->default_schematic;
 }
 
 /// \brief Gets a mutable event schematic map
+/// \details Copies the schematics first if they are shared
 /// \returns The mutable event schematic map
-auto Node::event_schematics() noexcept -> schematic_map_t& {
-	return event_schematics_;
+auto Node::event_schematics() -> schematic_map_t& {
+	detach();
+	return schematics_->event_schematics;
 }
 
 /// \brief Gets an immutable event schematic map
 /// \returns The immutable event schematic map
 auto Node::event_schematics() const noexcept -> const schematic_map_t& {
-	return event_schematics_;
+	return schematics_->event_schematics;
 }
 
 /// \brief Gets a mutable active schematic
+/// \details Copies the schematics first if they are shared
 /// \returns The mutable active schematic
-auto Node::active_schematic() noexcept -> std::reference_wrapper<Schematic>& {
+auto Node::active_schematic() -> std::reference_wrapper<Schematic>& {
+	detach();
 	return active_;
 }
 
 /// \brief Gets an immutable active schematic
 /// \returns The immutable active schematic
-auto Node::active_schematic() const noexcept -> const std::reference_wrapper<Schematic>& {
-	return active_;
+auto Node::active_schematic() const noexcept -> const Schematic& {
+	return active_.get();
+}
+
+/// \brief Switches the active schematic
+/// \details Only points the node at another schematic, shared schematics are not copied
+/// \param name The name of the event schematic, or an empty name for the default schematic
+/// \returns A boolean indicating whether the schematic exists, the active schematic is kept if it does not
+bool Node::set_active(const std::string& name) {
+	if (name.empty()) {
+		active_ = schematics_->default_schematic;
+		return true;
+	}
+
+	const auto it = schematics_->event_schematics.find(name);
+	if (it == schematics_->event_schematics.end()) return false;
+	active_ = it.value();
+	return true;
 }
 
 /// \brief Gets a mutable name
@@ -228,7 +302,90 @@ void Node::attach_event(const std::string& name) {
 
 /// \brief Detaches an event name from the set
 void Node::detach_event(const std::string& name) {
-	attached_events_.emplace(name);
+	attached_events_.erase(name);
+}
+
+/// \brief Gets a mutable delegated events set
+/// \returns The mutable delegated events set
+auto Node::delegated_events() noexcept -> tsl::hopscotch_set<std::string>& {
+	return delegated_events_;
+}
+
+/// \brief Gets an immutable delegated events set
+/// \returns The immutable delegated events set
+auto Node::delegated_events() const noexcept -> const tsl::hopscotch_set<std::string>& {
+	return delegated_events_;
+}
+
+/// \brief Delegates an event name to this node
+/// \details The event fires on this node whenever one of its descendants is the event target
+void Node::delegate_event(const std::string& name) {
+	delegated_events_.emplace(name);
+}
+
+/// \brief Removes a delegated event name from the set
+void Node::undelegate_event(const std::string& name) {
+	delegated_events_.erase(name);
+}
+
+/// \brief Gets the mutable names of the style classes the node was declared with
+/// \details A \sa cui::SceneGraph indexes the nodes by these when they are added to it
+/// \returns The mutable style class names
+auto Node::style_classes() noexcept -> std::vector<std::string>& {
+	return style_classes_;
+}
+
+/// \brief Gets the immutable names of the style classes the node was declared with
+/// \returns The immutable style class names
+auto Node::style_classes() const noexcept -> const std::vector<std::string>& {
+	return style_classes_;
+}
+
+/// \brief Compares the default and event schematics with those of another node
+/// \details Nodes sharing their schematics compare equal without looking at them
+/// \returns Boolean indicating whether all schematics are equal
+bool Node::same_schematics(const Node& rhs) const {
+	if (schematics_ == rhs.schematics_) return true;
+	return schematics_->default_schematic == rhs.schematics_->default_schematic &&
+		   schematics_->event_schematics == rhs.schematics_->event_schematics;
+}
+
+/// \brief Replaces the schematics with those of another node, shared copy-on-write
+/// \details Reassigns the active schematic to the default schematic
+void Node::share_schematics(const Node& rhs) {
+	schematics_ = rhs.schematics_;
+	active_ = schematics_->default_schematic;
+}
+
+/// \brief Gets the empty schematics that moved from nodes share
+/// \details Never written to, the mutable getters of a node sharing them make their own copy first
+auto Node::empty_schematics() noexcept -> const std::shared_ptr<Schematics>& {
+	static const auto empty = std::make_shared<Schematics>();
+	return empty;
+}
+
+/// \brief Points a moved from node at the empty schematics
+void Node::release_schematics() noexcept {
+	schematics_ = empty_schematics();
+	active_ = schematics_->default_schematic;
+}
+
+/// \brief Gives the node its own copy of shared schematics
+/// \details The active schematic is pointed at the same schematic inside the copy
+void Node::detach() {
+	if (schematics_.use_count() <= 1) return;
+
+	auto copy = std::make_shared<Schematics>(*schematics_);
+	if (&active_.get() == &schematics_->default_schematic) {
+		active_ = copy->default_schematic;
+	} else {
+		for (auto it = schematics_->event_schematics.begin(); it != schematics_->event_schematics.end(); ++it) {
+			if (&active_.get() != &it->second) continue;
+			active_ = copy->event_schematics.find(it->first).value();
+			break;
+		}
+	}
+	schematics_ = std::move(copy);
 }
 
 }	 // namespace cui
@@ -0,0 +1,147 @@
+#ifndef CUI_VISUAL_PROTOTYPE_HPP
+#define CUI_VISUAL_PROTOTYPE_HPP
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <aliases.hpp>
+#include <containers/nary_tree.hpp>
+#include <visual/node.hpp>
+
+namespace cui {
+
+/// \brief A subtree defined once and instantiated any amount of times
+/// \details Instances are copies of the prototype nodes, which share their schematics copy-on-write, see
+/// \sa cui::Node. An instance only owns the names, texts and event sets of its nodes until one of its
+/// schematics is changed, eg. its position, so memory grows with the overrides instead of the size of the
+/// prototype. The nodes are kept in pre-order with a single top level node, which is renamed per instance
+class Prototype
+{
+public:
+	using tree_t = NaryTree<Node>;
+	using size_type = std::size_t;
+
+	explicit Prototype(const tree_t& p_tree);
+
+	template <typename Tree>
+	[[nodiscard]] static auto from_graph(const Tree& graph, size_type index) -> Prototype;
+
+	[[nodiscard]] auto instantiate(const std::string& name) const -> tree_t;
+
+	[[nodiscard]] auto instantiate(size_type count, const std::string& name) const -> tree_t;
+
+	[[nodiscard]] auto tree() const noexcept -> const tree_t& {
+		return tree_;
+	}
+
+	[[nodiscard]] auto length() const noexcept -> size_type {
+		return tree_.length();
+	}
+
+private:
+	Prototype() = default;
+
+	template <typename Tree>
+	void copy_subtree(const Tree& source, size_type index);
+
+	void append_instance(tree_t& tree, const std::string& name) const;
+
+	tree_t tree_;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Builds a prototype from a tree with a single top level node
+/// \details The tree may be stored in any order, the copy is stored in pre-order. If the tree is empty or has
+/// more than one top level node, an exception is thrown
+/// \param p_tree The nodes of the prototype
+Prototype::Prototype(const tree_t& p_tree) {
+	size_type top_level = tree_t::npos;
+	for (size_type i = 0; i < p_tree.length(); ++i) {
+		if (p_tree[i].parent() != tree_t::no_parent) continue;
+		if (top_level != tree_t::npos) throw std::logic_error("A prototype has a single top level node");
+		top_level = i;
+	}
+	if (top_level == tree_t::npos) throw std::logic_error("A prototype needs at least one node");
+
+	this->copy_subtree(p_tree, top_level);
+}
+
+/// \brief Builds a prototype from a node of a graph and its descendants
+/// \tparam Tree A \sa cui::SceneGraph or any other \sa cui::NaryTree of \sa cui::Node
+/// \param graph The graph holding the node
+/// \param index The index of the node
+/// \returns The prototype
+template <typename Tree>
+auto Prototype::from_graph(const Tree& graph, const size_type index) -> Prototype {
+	Prototype prototype;
+	prototype.copy_subtree(graph, index);
+	return prototype;
+}
+
+/// \brief Instantiates the prototype once
+/// \param name The name of the top level node of the instance
+/// \returns The nodes of the instance, to be inserted with \sa SceneGraph::insert_subtree()
+auto Prototype::instantiate(const std::string& name) const -> tree_t {
+	tree_t tree;
+	tree.reserve(tree_.length());
+	this->append_instance(tree, name);
+	return tree;
+}
+
+/// \brief Instantiates the prototype several times into one tree
+/// \details Each instance is a top level node of the result, so all of them are inserted in a single pass
+/// \param count The amount of instances
+/// \param name The name prefix of the top level nodes, instance i is named <name>#<i>
+/// \returns The nodes of the instances, to be inserted with \sa SceneGraph::insert_subtree()
+auto Prototype::instantiate(const size_type count, const std::string& name) const -> tree_t {
+	tree_t tree;
+	tree.reserve(tree_.length() * count);
+	for (size_type i = 0; i < count; ++i) this->append_instance(tree, name + '#' + std::to_string(i));
+	return tree;
+}
+
+/// \brief Copies a node and its descendants in pre-order
+/// \param source The tree holding the node
+/// \param index The index of the node
+template <typename Tree>
+void Prototype::copy_subtree(const Tree& source, const size_type index) {
+	std::vector<std::pair<size_type, size_type>> pending{{index, tree_t::no_parent}};
+	while (!pending.empty()) {
+		const auto [current, parent] = pending.back();
+		pending.pop_back();
+
+		const auto& node = source[current];
+		if (parent == tree_t::no_parent) {
+			tree_.add_node(node.data());
+		} else {
+			tree_.add_node(node.data(), parent);
+		}
+
+		const auto added = tree_.length() - 1;
+		for (auto it = node.children().rbegin(); it != node.children().rend(); ++it) pending.emplace_back(*it, added);
+	}
+}
+
+/// \brief Appends one instance behind the nodes of a tree
+/// \details Node copies only share the schematics of the prototype, children lists are sized up front
+/// \param tree The tree to append to
+/// \param name The name of the top level node of the instance
+void Prototype::append_instance(tree_t& tree, const std::string& name) const {
+	const auto offset = tree.length();
+	for (size_type i = 0; i < tree_.length(); ++i) {
+		if (i == 0) {
+			tree.add_node(tree_[i].data());
+			tree[offset].data().name() = name;
+		} else {
+			tree.add_node(tree_[i].data(), tree_[i].parent() + offset);
+		}
+		if (tree_[i].children().size() > 1) tree[offset + i].children().reserve(tree_[i].children().size());
+	}
+}
+
+}	 // namespace cui
+
+#endif	  // CUI_VISUAL_PROTOTYPE_HPP
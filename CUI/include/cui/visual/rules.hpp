@@ -31,6 +31,10 @@ public:
 
 	[[nodiscard]] bool text_position_rule() const noexcept;
 
+	[[nodiscard]] bool operator==(const Rules& rhs) const noexcept {
+		return enabled_rules_ == rhs.enabled_rules_;
+	}
+
 protected:
 	void set_nth_bit(bool val, int n) noexcept {
 		if (val) {
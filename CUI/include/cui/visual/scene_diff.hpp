@@ -0,0 +1,311 @@
+#ifndef CUI_VISUAL_SCENE_DIFF_HPP
+#define CUI_VISUAL_SCENE_DIFF_HPP
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <aliases.hpp>
+#include <containers/nary_tree.hpp>
+#include <tsl/hopscotch_map.h>
+#include <visual/node.hpp>
+
+namespace cui {
+
+/// \brief Edit script turning a live node tree into a target tree
+/// \details Nodes are matched by name. Names that repeat inside a tree, eg. the parts of instanced prototypes,
+/// are matched by the key of their parent, their name and their occurrence among equally named siblings.
+/// Matched nodes keep their place unless their parent changed or they fall outside the longest run of
+/// siblings that kept their order, so a reordering moves as few nodes as possible. Unmatched target nodes are
+/// inserted as whole subtrees and unmatched live nodes are removed with their descendants. Matched nodes whose
+/// text or schematics changed are updated in place. Schematics are compared as they are, so resource paths of
+/// both trees have to be in the same form, see \sa Window::patch(). The root node is not part of the diff.
+///
+/// Edits refer to nodes by id: a live node by its index when the diff was computed, a target node that gets
+/// inserted by \sa SceneDiff::current_length() plus its target index. Edits are ordered so that the parent
+/// and the previous sibling of every insert or move are in place when it is applied, removals come last.
+/// A diff has to be applied to the unchanged tree it was computed against, see \sa Window::apply_diff()
+class SceneDiff
+{
+public:
+	using tree_t = NaryTree<Node>;
+	using size_type = std::size_t;
+	static constexpr size_type npos = -1;
+
+	enum class Kind : u8
+	{
+		Insert,
+		Move,
+		Update,
+		Remove
+	};
+
+	struct Edit
+	{
+		explicit Edit(const Kind p_kind) : kind(p_kind) {}
+
+		Kind kind;
+		// The node to move, update or remove, or the first node of an insert
+		size_type node = npos;
+		// The new parent of an insert or move, npos for a top level node
+		size_type parent = npos;
+		// The new previous sibling of an insert or move, npos for the first child
+		size_type after = npos;
+		// The nodes of an insert and their ids, in index order
+		tree_t subtree;
+		std::vector<size_type> ids;
+		// The target node of an update and what changed
+		std::optional<Node> source;
+		bool text = false;
+		bool schematics = false;
+	};
+
+	SceneDiff(const tree_t& current, const tree_t& target);
+
+	[[nodiscard]] auto edits() const noexcept -> const std::vector<Edit>& {
+		return edits_;
+	}
+
+	[[nodiscard]] auto current_length() const noexcept -> size_type {
+		return current_length_;
+	}
+
+	[[nodiscard]] auto id_count() const noexcept -> size_type {
+		return current_length_ + target_length_;
+	}
+
+	[[nodiscard]] bool empty() const noexcept {
+		return edits_.empty();
+	}
+
+	[[nodiscard]] auto count(const Kind kind) const noexcept -> size_type {
+		return static_cast<size_type>(std::count_if(edits_.begin(), edits_.end(), [kind](const Edit& e) { return e.kind == kind; }));
+	}
+
+	[[nodiscard]] static auto keys(const tree_t& tree) -> std::vector<std::string>;
+
+private:
+	[[nodiscard]] static auto top_level(const tree_t& tree) -> std::vector<size_type>;
+	[[nodiscard]] static auto longest_increasing(const std::vector<size_type>& values) -> std::vector<bool>;
+
+	size_type current_length_;
+	size_type target_length_;
+	std::vector<Edit> edits_;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Computes the edit script
+/// \details O(n + m) hashing for n live and m target nodes, plus O(k log k) per sibling list of k nodes for the
+/// order. The target nodes are copied into the edits, sharing their schematics copy-on-write
+/// \param current The live tree, eg. the graph of the active scene
+/// \param target The tree to turn it into, eg. a \sa cui::SceneGraph built from a new \sa ct::Scene
+SceneDiff::SceneDiff(const tree_t& current, const tree_t& target) : current_length_(current.length()), target_length_(target.length()) {
+	const auto current_keys = keys(current);
+	const auto target_keys = keys(target);
+
+	tsl::hopscotch_map<std::string, size_type> current_by_key;
+	current_by_key.reserve(current.length());
+	for (size_type i = 0; i < current.length(); ++i) current_by_key.emplace(current_keys[i], i);
+
+	std::vector<size_type> match(target.length(), npos);
+	std::vector<bool> matched(current.length(), false);
+	for (size_type t = 0; t < target.length(); ++t) {
+		const auto it = current_by_key.find(target_keys[t]);
+		if (it == current_by_key.end()) continue;
+		match[t] = it->second;
+		matched[it->second] = true;
+	}
+
+	const auto current_roots = top_level(current);
+	const auto target_roots = top_level(target);
+
+	std::vector<size_type> position(current.length(), 0);
+	for (size_type i = 0; i < current_roots.size(); ++i) position[current_roots[i]] = i;
+	for (const auto& node : current) {
+		for (size_type i = 0; i < node.children().size(); ++i) position[node.children()[i]] = i;
+	}
+
+	const auto target_id = [&](const size_type t) -> size_type {
+		if (t == tree_t::no_parent) return npos;
+		return match[t] != npos ? match[t] : current_length_ + t;
+	};
+	const auto current_parent = [&](const size_type i) -> size_type {
+		return current[i].parent() == tree_t::no_parent ? npos : current[i].parent();
+	};
+
+	// Matched children that stay under the same parent keep their place if they are part of the longest run
+	// that kept its relative order
+	std::vector<bool> stable(target.length(), false);
+	const auto mark_stable = [&](const std::vector<size_type>& children, const size_type parent) {
+		std::vector<size_type> candidates;
+		std::vector<size_type> positions;
+		for (const auto t : children) {
+			if (match[t] == npos || current_parent(match[t]) != target_id(parent)) continue;
+			candidates.push_back(t);
+			positions.push_back(position[match[t]]);
+		}
+		const auto keep = longest_increasing(positions);
+		for (size_type i = 0; i < candidates.size(); ++i) stable[candidates[i]] = keep[i];
+	};
+	mark_stable(target_roots, tree_t::no_parent);
+	for (size_type t = 0; t < target.length(); ++t) mark_stable(target[t].children(), t);
+
+	std::vector<bool> handled(target.length(), false);
+	struct Pending
+	{
+		size_type node;
+		size_type parent;
+		size_type after;
+	};
+	std::vector<Pending> pending;
+	const auto push_children = [&pending](const std::vector<size_type>& children, const size_type parent) {
+		for (auto i = children.size(); i-- > 0;) pending.push_back({children[i], parent, i == 0 ? tree_t::no_parent : children[i - 1]});
+	};
+	push_children(target_roots, tree_t::no_parent);
+
+	while (!pending.empty()) {
+		const auto [t, parent, after] = pending.back();
+		pending.pop_back();
+		push_children(target[t].children(), t);
+		if (handled[t]) continue;
+
+		if (match[t] == npos) {
+			Edit edit(Kind::Insert);
+			edit.node = target_id(t);
+			edit.parent = target_id(parent);
+			edit.after = target_id(after);
+
+			std::vector<std::pair<size_type, size_type>> subtree{{t, tree_t::no_parent}};
+			while (!subtree.empty()) {
+				const auto [current_t, subtree_parent] = subtree.back();
+				subtree.pop_back();
+
+				handled[current_t] = true;
+				if (subtree_parent == tree_t::no_parent) {
+					edit.subtree.add_node(target[current_t].data());
+				} else {
+					edit.subtree.add_node(target[current_t].data(), subtree_parent);
+				}
+				edit.ids.push_back(target_id(current_t));
+
+				const auto added = edit.subtree.length() - 1;
+				const auto& children = target[current_t].children();
+				for (auto it = children.rbegin(); it != children.rend(); ++it) {
+					if (match[*it] == npos) subtree.emplace_back(*it, added);
+				}
+			}
+			edits_.push_back(std::move(edit));
+			continue;
+		}
+
+		if (!stable[t]) {
+			Edit edit(Kind::Move);
+			edit.node = match[t];
+			edit.parent = target_id(parent);
+			edit.after = target_id(after);
+			edits_.push_back(std::move(edit));
+		}
+
+		const auto& live = current[match[t]].data();
+		const auto& wanted = target[t].data();
+		const auto text = live.text() != wanted.text();
+		const auto schematics = !live.same_schematics(wanted);
+		if (text || schematics) {
+			Edit edit(Kind::Update);
+			edit.node = match[t];
+			edit.source.emplace(wanted);
+			edit.text = text;
+			edit.schematics = schematics;
+			edits_.push_back(std::move(edit));
+		}
+	}
+
+	for (size_type i = 0; i < current.length(); ++i) {
+		if (matched[i]) continue;
+		const auto parent = current[i].parent();
+		if (parent != tree_t::no_parent && !matched[parent]) continue;
+
+		Edit edit(Kind::Remove);
+		edit.node = i;
+		edits_.push_back(std::move(edit));
+	}
+}
+
+/// \brief Computes the matching key of every node
+/// \details A name that occurs once in the tree is its own key. Other nodes are keyed by the key of their
+/// parent, their name and their occurrence among the siblings of the same name
+/// \param tree The tree to key
+/// \returns The keys by node index
+auto SceneDiff::keys(const tree_t& tree) -> std::vector<std::string> {
+	tsl::hopscotch_map<std::string, size_type> occurrences;
+	occurrences.reserve(tree.length());
+	for (const auto& node : tree) ++occurrences[node.data().name()];
+
+	std::vector<std::string> result(tree.length());
+	tsl::hopscotch_map<std::string, size_type> siblings;
+	const auto assign = [&](const std::vector<size_type>& children, const std::string& parent_key) {
+		// Erased by name instead of cleared, clearing walks every bucket a long sibling list left behind
+		for (const auto child : children) siblings.erase(tree[child].data().name());
+		for (const auto child : children) {
+			const auto& name = tree[child].data().name();
+			const auto occurrence = siblings[name]++;
+			if (occurrences[name] == 1) {
+				result[child] = name;
+			} else {
+				result[child] = parent_key + '/' + name + ':' + std::to_string(occurrence);
+			}
+		}
+	};
+
+	auto pending = top_level(tree);
+	assign(pending, std::string{});
+	while (!pending.empty()) {
+		const auto current = pending.back();
+		pending.pop_back();
+
+		const auto& children = tree[current].children();
+		assign(children, result[current]);
+		pending.insert(pending.end(), children.begin(), children.end());
+	}
+	return result;
+}
+
+/// \brief Gets the top level nodes in index order
+auto SceneDiff::top_level(const tree_t& tree) -> std::vector<size_type> {
+	std::vector<size_type> roots;
+	for (size_type i = 0; i < tree.length(); ++i) {
+		if (tree[i].parent() == tree_t::no_parent) roots.push_back(i);
+	}
+	return roots;
+}
+
+/// \brief Finds a longest strictly increasing subsequence
+/// \details Patience sorting, O(k log k)
+/// \param values The sequence
+/// \returns Whether each value is part of the subsequence
+auto SceneDiff::longest_increasing(const std::vector<size_type>& values) -> std::vector<bool> {
+	std::vector<size_type> tails;
+	std::vector<size_type> previous(values.size(), npos);
+	for (size_type i = 0; i < values.size(); ++i) {
+		const auto it = std::lower_bound(tails.begin(), tails.end(), values[i], [&values](const size_type idx, const size_type value) {
+			return values[idx] < value;
+		});
+		if (it != tails.begin()) previous[i] = *(it - 1);
+		if (it == tails.end()) {
+			tails.push_back(i);
+		} else {
+			*it = i;
+		}
+	}
+
+	std::vector<bool> keep(values.size(), false);
+	for (auto i = tails.empty() ? npos : tails.back(); i != npos; i = previous[i]) keep[i] = true;
+	return keep;
+}
+
+}	 // namespace cui
+
+#endif	  // CUI_VISUAL_SCENE_DIFF_HPP
@@ -4,24 +4,38 @@
 #include <utils/print.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <iterator>
 #include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <aliases.hpp>
 #include <compile_time/scene.hpp>
 #include <compile_time/style.hpp>
 #include <containers/nary_tree.hpp>
+#include <tsl/hopscotch_map.h>
 #include <visual/node.hpp>
 
 namespace cui {
 
 /// \brief An Nary tree of \sa cui::Node
+/// \details Keeps a node name index and a style class index so lookups by name or style do not scan the tree.
+/// A name resolves to the first node indexed under it, further nodes carrying the name, eg. the descendants of
+/// prototype instances, are reported by \sa SceneGraph::duplicate_names(). Every structural change draws a new generation, unique across all graphs, so a node index can be kept
+/// together with the generation it was taken at and checked for validity later
 class SceneGraph : public NaryTree<Node>
 {
 public:
 	using tree_t = NaryTree<Node>;
 	using data_type = typename tree_t::data_type;
 	using size_type = typename tree_t::size_type;
+	using name_index_t = tsl::hopscotch_map<std::string, size_type>;
+	using style_index_t = tsl::hopscotch_map<std::string, std::vector<size_type>>;
+	using duplicate_names_t = tsl::hopscotch_map<std::string, size_type>;
+	using remap_t = typename tree_t::remap_t;
 	static constexpr u64 root_index = -1;
 
 	// Compile time graph generation
@@ -42,8 +56,43 @@ public:
 
 	void apply_style(data_type& node, const ct::Style& style);
 
+	[[nodiscard]] auto find_index(const std::string& name) const noexcept -> std::optional<size_type>;
+
+	[[nodiscard]] auto find_node(const std::string& name) noexcept -> data_type*;
+
+	[[nodiscard]] auto find_node(const std::string& name) const noexcept -> const data_type*;
+
+	[[nodiscard]] auto indices_with_style(const std::string& style_name) const noexcept -> const std::vector<size_type>&;
+
+	void reindex_names();
+
+	[[nodiscard]] auto duplicate_names() const noexcept -> const duplicate_names_t& {
+		return duplicate_names_;
+	}
+
+	[[nodiscard]] auto generation() const noexcept -> u64 {
+		return generation_;
+	}
+
+	void link_parents();
+
+	auto insert_subtree(size_type parent, tree_t&& subtree, size_type child_position = tree_t::npos) -> remap_t;
+
+	auto remove_subtree(size_type index) -> remap_t;
+
 private:
+	void index_name(size_type index);
+	void index_styles(size_type index);
+	void remap_indices(const remap_t& remap);
+	void release_duplicates(std::vector<std::string>&& removed_names);
+
+	[[nodiscard]] static auto next_generation() noexcept -> u64;
+
 	data_type root_;
+	name_index_t name_index_;
+	style_index_t style_index_;
+	duplicate_names_t duplicate_names_;
+	u64 generation_ = next_generation();
 };
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -52,6 +101,7 @@ private:
 template <u64 AOB, template <typename, u64> typename Container, u64 N>
 SceneGraph::SceneGraph(const ct::Scene<AOB>& sr, const Container<ct::Style, N>& sc) : tree_t{}, root_() {
 	this->vec_.reserve(AOB);
+	name_index_.reserve(sr.length());
 
 	for (const auto& style : sc) {
 		if (style.name().compare("root") == 0) {
@@ -65,11 +115,14 @@ SceneGraph::SceneGraph(const ct::Scene<AOB>& sr, const Container<ct::Style, N>&
 		const auto& [t_block, t_children, t_depth] = sr.get(i);
 		this->emplace_back(data_type(t_block.name(), t_block.text()), children_t{}, t_depth);
 		auto& node = this->back();
+		node.children().reserve(t_children.size());
 		for (const auto idx : t_children) node.children().push_back(idx);
 
 		auto& node_data = node.data();
+		index_name(i);
 
 		for (const auto style_name : t_block.style_list()) {
+			style_index_[node_data.style_classes().emplace_back(style_name.begin(), style_name.end())].push_back(i);
 			for (const auto& style : sc) {
 				if (style.name().compare("root") == 0) continue;
 				if (style_name != style.name()) continue;
@@ -77,12 +130,15 @@ SceneGraph::SceneGraph(const ct::Scene<AOB>& sr, const Container<ct::Style, N>&
 			}
 		}
 	}
+
+	link_parents();
 }
 
 /// \brief Generates the graph from a \sa ct::Scene and a container of \sa ct::Style
 template <u64 AOB, template <typename> typename Container>
 SceneGraph::SceneGraph(const ct::Scene<AOB>& sr, const Container<ct::Style>& sc) {
 	this->vec_.reserve(AOB);
+	name_index_.reserve(sr.length());
 
 	for (const auto& style : sc) {
 		if (style.name().compare("root") == 0) {
@@ -96,11 +152,14 @@ SceneGraph::SceneGraph(const ct::Scene<AOB>& sr, const Container<ct::Style>& sc)
 		const auto& [t_block, t_children, t_depth] = sr.get(i);
 		this->emplace_back(data_type(t_block.name(), t_block.text()), children_t{}, t_depth);
 		auto& node = this->back();
+		node.children().reserve(t_children.size());
 		for (const auto idx : t_children) node.children().push_back(idx);
 
 		auto& node_data = node.data();
+		index_name(i);
 
 		for (const auto style_name : t_block.style_list()) {
+			style_index_[node_data.style_classes().emplace_back(style_name.begin(), style_name.end())].push_back(i);
 			for (const auto& style : sc) {
 				if (style.name().compare("root") == 0) continue;
 				if (style_name != style.name()) continue;
@@ -108,18 +167,16 @@ SceneGraph::SceneGraph(const ct::Scene<AOB>& sr, const Container<ct::Style>& sc)
 			}
 		}
 	}
+
+	link_parents();
 }
 
 /// \brief Gets the index of the parent of the searched for node
+/// \details Reads the parent link stored in the node, top level nodes are parented to the root
 auto SceneGraph::get_parent_index(const size_type index) const noexcept -> size_type {
-	if (index == root_index) return root_index;
-	const auto it = std::find_if(this->begin(), this->end(), [index](const auto& node) {
-		const auto& children = node.children();
-		return std::find(children.begin(), children.end(), index) != children.end();
-	});
-	if (it == this->end()) return root_index;
+	if (index == root_index || index >= this->length()) return root_index;
 
-	return std::distance(this->begin(), it);
+	return this->operator[](index).parent();
 }
 
 /// \brief Gets the parent of a searched for node
@@ -149,6 +206,190 @@ void SceneGraph::apply_style(data_type& node, const ct::Style& style) {
 	}
 }
 
+/// \brief Looks up the index of a node by name
+/// \details If several nodes share a name, the first one in the graph is found
+/// \param name The name of the node to search for
+/// \returns The index of the node, \sa SceneGraph::root_index for the root node or nothing if no node is found
+auto SceneGraph::find_index(const std::string& name) const noexcept -> std::optional<size_type> {
+	if (root_.name() == name) return root_index;
+
+	const auto it = name_index_.find(name);
+	if (it == name_index_.end()) return std::nullopt;
+
+	return it->second;
+}
+
+/// \brief Looks up a mutable node by name
+/// \param name The name of the node to search for
+/// \returns A pointer to the node or a nullptr if no node is found
+auto SceneGraph::find_node(const std::string& name) noexcept -> data_type* {
+	const auto idx = find_index(name);
+	if (!idx) return nullptr;
+	if (*idx == root_index) return &root_;
+
+	return &this->operator[](*idx).data();
+}
+
+/// \brief Looks up an immutable node by name
+/// \param name The name of the node to search for
+/// \returns A pointer to the node or a nullptr if no node is found
+auto SceneGraph::find_node(const std::string& name) const noexcept -> const data_type* {
+	const auto idx = find_index(name);
+	if (!idx) return nullptr;
+	if (*idx == root_index) return &root_;
+
+	return &this->operator[](*idx).data();
+}
+
+/// \brief Gets the indices of the nodes a style class was applied to
+/// \param style_name The name of the style class
+/// \returns The node indices in graph order, empty if the style class is unused
+auto SceneGraph::indices_with_style(const std::string& style_name) const noexcept -> const std::vector<size_type>& {
+	static const std::vector<size_type> none{};
+	const auto it = style_index_.find(style_name);
+	if (it == style_index_.end()) return none;
+
+	return it->second;
+}
+
+/// \brief Rebuilds the node name index
+/// \details Needs to be called after nodes are renamed or the graph is modified directly through the \sa cui::NaryTree interface
+void SceneGraph::reindex_names() {
+	generation_ = next_generation();
+	name_index_.clear();
+	duplicate_names_.clear();
+	name_index_.reserve(this->length());
+	for (size_type i = 0; i < this->length(); ++i) index_name(i);
+}
+
+/// \brief Sets the parent link of every node from the children lists
+/// \details Nodes that are nobody's child get parented to the root
+void SceneGraph::link_parents() {
+	for (auto& node : *this) node.parent() = root_index;
+	for (size_type i = 0; i < this->length(); ++i) {
+		for (const auto child : this->operator[](i).children()) this->operator[](child).parent() = i;
+	}
+}
+
+/// \brief Inserts a tree of nodes below a node
+/// \details See \sa NaryTree::insert_subtree(). The name and style class indices are remapped incrementally,
+/// the inserted nodes are added to them by their names and \sa Node::style_classes()
+/// \param parent The index of the parent, \sa SceneGraph::root_index inserts top level nodes
+/// \param subtree The nodes to insert with depths relative to their top level nodes
+/// \param child_position The position among the children of the parent, appends by default
+/// \returns The remap describing the inserted range, eg. for \sa RenderCache::apply_remap()
+auto SceneGraph::insert_subtree(const size_type parent, tree_t&& subtree, const size_type child_position) -> remap_t {
+	const auto remap = tree_t::insert_subtree(parent, std::move(subtree), child_position);
+	if (remap.empty()) return remap;
+
+	remap_indices(remap);
+	generation_ = next_generation();
+	for (auto i = remap.position(); i < remap.position() + remap.inserted(); ++i) {
+		index_name(i);
+		index_styles(i);
+	}
+	return remap;
+}
+
+/// \brief Removes a node together with all of its descendants
+/// \details See \sa NaryTree::remove_subtree(). The name and style class indices are remapped incrementally.
+/// A removed node that a name resolved to hands the name over to the next node carrying it
+/// \param index The index of the node to remove
+/// \returns The remap describing the removed indices, eg. for \sa RenderCache::apply_remap()
+auto SceneGraph::remove_subtree(const size_type index) -> remap_t {
+	if (index == root_index) throw std::logic_error("The root node cannot be removed");
+
+	std::vector<std::string> removed_names;
+	if (!duplicate_names_.empty() && index < this->length()) {
+		std::vector<size_type> pending{index};
+		while (!pending.empty()) {
+			const auto& node = this->operator[](pending.back());
+			pending.pop_back();
+			if (duplicate_names_.contains(node.data().name())) removed_names.push_back(node.data().name());
+			pending.insert(pending.end(), node.children().begin(), node.children().end());
+		}
+	}
+
+	const auto remap = tree_t::remove_subtree(index);
+	if (remap.empty()) return remap;
+
+	remap_indices(remap);
+	release_duplicates(std::move(removed_names));
+	generation_ = next_generation();
+	return remap;
+}
+
+/// \brief Moves the entries of the name and style class indices to the remapped node indices
+/// \details Entries of removed nodes are dropped. Visits every index entry once
+void SceneGraph::remap_indices(const remap_t& remap) {
+	for (auto it = name_index_.begin(); it != name_index_.end();) {
+		const auto idx = remap.map(it->second);
+		if (idx == remap_t::npos) {
+			it = name_index_.erase(it);
+			continue;
+		}
+		it.value() = idx;
+		++it;
+	}
+
+	for (auto it = style_index_.begin(); it != style_index_.end(); ++it) {
+		auto& indices = it.value();
+		auto out = indices.begin();
+		for (const auto idx : indices) {
+			const auto mapped = remap.map(idx);
+			if (mapped != remap_t::npos) *out++ = mapped;
+		}
+		indices.erase(out, indices.end());
+	}
+}
+
+/// \brief Adds a node to the name index
+/// \details A name already indexed keeps its node, the node is counted in \sa SceneGraph::duplicate_names()
+/// \param index The index of the node
+void SceneGraph::index_name(const size_type index) {
+	const auto& name = this->operator[](index).data().name();
+	if (!name_index_.emplace(name, index).second) ++duplicate_names_[name];
+}
+
+/// \brief Adds a node to the index of each of its style classes
+/// \details The indices of a style class stay in graph order
+/// \param index The index of the node
+void SceneGraph::index_styles(const size_type index) {
+	for (const auto& style_class : this->operator[](index).data().style_classes()) {
+		auto& indices = style_index_[style_class];
+		indices.insert(std::lower_bound(indices.begin(), indices.end(), index), index);
+	}
+}
+
+/// \brief Settles the duplicate counts and the name index after nodes carrying duplicated names were removed
+/// \details Names whose indexed node was removed resolve to the first remaining node carrying them
+/// \param removed_names The duplicated name of every removed node carrying one
+void SceneGraph::release_duplicates(std::vector<std::string>&& removed_names) {
+	for (const auto& name : removed_names) {
+		const auto it = duplicate_names_.find(name);
+		if (it == duplicate_names_.end()) continue;
+		if (--it.value() == 0) duplicate_names_.erase(it);
+	}
+
+	std::sort(removed_names.begin(), removed_names.end());
+	removed_names.erase(std::unique(removed_names.begin(), removed_names.end()), removed_names.end());
+
+	for (const auto& name : removed_names) {
+		if (name_index_.contains(name)) continue;
+		for (size_type i = 0; i < this->length(); ++i) {
+			if (this->operator[](i).data().name() != name) continue;
+			name_index_.emplace(name, i);
+			break;
+		}
+	}
+}
+
+/// \brief Draws a generation no graph has had before
+auto SceneGraph::next_generation() noexcept -> u64 {
+	static std::atomic<u64> counter{0};
+	return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
 /// \brief Gets a mutable root node
 /// \returns The mutable root node
 auto SceneGraph::root() noexcept -> data_type& {
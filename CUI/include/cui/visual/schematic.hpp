@@ -20,6 +20,14 @@ public:
 	Schematic() noexcept = default;
 
 	void assign(const ct::styles::AttributeData& attr_data);
+
+	[[nodiscard]] bool operator==(const Schematic& rhs) const noexcept {
+		return Attributes::operator==(rhs) && Rules::operator==(rhs);
+	}
+
+	[[nodiscard]] bool operator!=(const Schematic& rhs) const noexcept {
+		return !operator==(rhs);
+	}
 };
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,69 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+
+#include <cui/compile_time/scenes/parse_scenes.hpp>
+#include <cui/compile_time/styles/parse_styles.hpp>
+#include <cui/visual/prototype.hpp>
+#include <window.hpp>
+
+using namespace cui;
+
+constexpr char styles__[] = R"(
+root {
+	background: rgb(0, 0, 0);
+}
+
+list {
+	width: 400;
+	height: 600;
+}
+)";
+
+constexpr char scene__[] = R"(
+list "list"
+)";
+
+/// \brief Times Window::patch for k moves and k text changes among the n children of a list
+/// \details The cost is dominated by the structural edits, each shifting the graph and the cache once
+auto measure(const std::vector<ct::Style>& styles, const std::size_t length, const std::size_t edit_count) -> double {
+	constexpr auto scene_variant = ct::scenes::parse_scenes<scene__>();
+	Window window(styles, scene_variant.type_a());
+	window.simulate(std::chrono::milliseconds(0), std::chrono::milliseconds(1));
+
+	Window::tree_t rows;
+	rows.reserve(length);
+	for (std::size_t i = 0; i < length; ++i) rows.add_node(Node("row" + std::to_string(i), std::string("text")));
+	window.insert_subtree("list", std::move(rows));
+
+	std::mt19937 rng(static_cast<unsigned>(length + edit_count));
+	Window::tree_t target = window.active_scene().graph();
+	for (std::size_t k = 0; k < edit_count; ++k) {
+		const auto index = 1 + rng() % length;
+		const auto moved = Prototype::from_graph(target, index);
+		target.remove_subtree(index);
+		target.insert_subtree(0, Window::tree_t(moved.tree()));
+		target[1 + rng() % length].data().text() = "changed";
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+	const auto diff = window.patch(target);
+	const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	if (diff.empty()) std::printf("the patch found no edits\n");
+	return elapsed;
+}
+
+int main() {
+	constexpr auto styles_variant = ct::styles::parse_styles<styles__>();
+	std::vector<ct::Style> styles;
+	for (const auto& el : styles_variant.type_a()) styles.push_back(ct::Style::create(el).type_a());
+
+	std::printf("%10s %10s %14s\n", "nodes", "edits", "patch [ms]");
+	for (const std::size_t length : {1000, 4000, 16000}) {
+		for (const std::size_t edit_count : {1, 16, 256}) {
+			std::printf("%10zu %10zu %14.3f\n", length, edit_count, measure(styles, length, edit_count));
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,76 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <thread>
+
+#include <cui/compile_time/scenes/parse_scenes.hpp>
+#include <cui/compile_time/styles/parse_styles.hpp>
+#include <window.hpp>
+
+using namespace cui;
+
+constexpr char styles__[] = R"(
+root {
+	background: rgb(116, 109, 105);
+}
+
+panel {
+	background: rgb(80, 80, 80);
+	x: center;
+	y: center;
+	width: 400;
+	height: 300;
+}
+)";
+
+constexpr char scene__[] = R"(
+panel "panel"
+)";
+
+/// \brief Opens a window for a while and reports the latency from polling input until it was displayed
+/// \details Needs a display and someone moving the mouse over the window. Every mouse move costs the given
+/// amount of UI work and changes the frame, which is what the pipelined mode overlaps with drawing
+/// \param pipelined Whether the frames are drawn on a render thread, see \sa WindowOptions::pipelined
+void measure(const std::vector<ct::Style>& styles, const bool pipelined, const std::chrono::seconds duration, const std::chrono::microseconds work) {
+	constexpr auto scene_variant = ct::scenes::parse_scenes<scene__>();
+	Window window(styles, scene_variant.type_a());
+	window.register_global_event(sf::Event::EventType::MouseMoved, "on_move", [&window, work](Window::event_data_t) {
+		const auto until = std::chrono::steady_clock::now() + work;
+		while (std::chrono::steady_clock::now() < until) {
+		}
+		window.schedule_to_update_cache();
+	});
+
+	const WindowOptions options{800, 600, "Move the mouse over the window", sf::Style::Default, sf::ContextSettings{}, 60, 0, false, pipelined};
+	window.init(options);
+	std::this_thread::sleep_for(duration);
+	std::promise<Window::latency_histogram_t> result;
+	window.post_to_ui([&window, &result] {
+		result.set_value(window.input_latency());
+		window.close();
+	});
+
+	const auto latency = result.get_future().get();
+	const auto ms = [](const auto value) { return std::chrono::duration<double, std::milli>(value).count(); };
+	std::printf("%10s %10llu %10.2f %10.2f %10.2f\n",
+				pipelined ? "pipelined" : "serial",
+				static_cast<unsigned long long>(latency.count()),
+				ms(latency.p50()),
+				ms(latency.p99()),
+				ms(latency.max()));
+}
+
+int main(int argc, char** argv) {
+	const auto duration = std::chrono::seconds(argc > 1 ? std::atoi(argv[1]) : 10);
+	const auto work = std::chrono::microseconds(argc > 2 ? std::atoi(argv[2]) : 4000);
+
+	constexpr auto styles_variant = ct::styles::parse_styles<styles__>();
+	std::vector<ct::Style> styles;
+	for (const auto& el : styles_variant.type_a()) styles.push_back(ct::Style::create(el).type_a());
+
+	std::printf("%10s %10s %10s %10s %10s\n", "mode", "frames", "p50 [ms]", "p99 [ms]", "max [ms]");
+	measure(styles, false, duration, work);
+	measure(styles, true, duration, work);
+	return 0;
+}
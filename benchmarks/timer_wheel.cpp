@@ -0,0 +1,77 @@
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+
+#include <detail/timer_wheel.hpp>
+
+using namespace cui;
+
+using time_point_t = TimerWheel::time_point_t;
+using milliseconds_t = std::chrono::duration<double, std::milli>;
+
+constexpr std::size_t timer_count = 100'000;
+
+/// \brief Random deadlines spread over a span after the start
+auto make_deadlines(const time_point_t start, const std::chrono::milliseconds span) -> std::vector<time_point_t> {
+	std::mt19937_64 rng(timer_count);
+	std::vector<time_point_t> deadlines(timer_count);
+	for (auto& deadline : deadlines) deadline = start + std::chrono::microseconds(rng() % (span.count() * 1000));
+	return deadlines;
+}
+
+/// \brief Schedules every timer on a wheel and drains it by advancing in steps of a fixed length
+/// \details With a step of one tick every tick is visited, which is what advancing cost before it skipped empty slots
+auto measure_wheel(const std::vector<time_point_t>& deadlines, const time_point_t start, const std::chrono::milliseconds step) -> double {
+	const auto begin = std::chrono::steady_clock::now();
+	TimerWheel wheel(start, std::chrono::milliseconds(1));
+	for (const auto deadline : deadlines) wheel.schedule(TimerEvent([] {}, deadline));
+
+	std::size_t expired = 0;
+	const auto sink = [&expired](TimerEvent&&) { ++expired; };
+	for (auto now = start; !wheel.empty(); now += step) wheel.advance(now, sink);
+
+	const auto elapsed = milliseconds_t(std::chrono::steady_clock::now() - begin).count();
+	if (expired != deadlines.size()) std::printf("the wheel lost timers\n");
+	return elapsed;
+}
+
+/// \brief Same as \sa measure_wheel with a binary heap ordered by deadline
+auto measure_queue(const std::vector<time_point_t>& deadlines, const time_point_t start, const std::chrono::milliseconds step) -> double {
+	const auto begin = std::chrono::steady_clock::now();
+	std::priority_queue<TimerEvent, std::vector<TimerEvent>, std::greater<>> queue;
+	for (const auto deadline : deadlines) queue.emplace([] {}, deadline);
+
+	std::size_t expired = 0;
+	for (auto now = start; !queue.empty(); now += step) {
+		while (!queue.empty() && queue.top().deadline() <= now) {
+			queue.pop();
+			++expired;
+		}
+	}
+
+	const auto elapsed = milliseconds_t(std::chrono::steady_clock::now() - begin).count();
+	if (expired != deadlines.size()) std::printf("the queue lost timers\n");
+	return elapsed;
+}
+
+int main() {
+	const auto start = std::chrono::steady_clock::now();
+
+	std::printf("%10zu timers, 1ms ticks\n", timer_count);
+	std::printf("%10s %10s %16s %16s %16s\n", "span [s]", "step [ms]", "wheel [ms]", "1ms steps [ms]", "heap [ms]");
+	for (const auto span : {std::chrono::seconds(10), std::chrono::seconds(600), std::chrono::seconds(86'400)}) {
+		const auto deadlines = make_deadlines(start, span);
+		for (const auto step : {std::chrono::milliseconds(16), std::chrono::milliseconds(1000)}) {
+			std::printf("%10lld %10lld %16.3f %16.3f %16.3f\n",
+						static_cast<long long>(span.count()),
+						static_cast<long long>(step.count()),
+						measure_wheel(deadlines, start, step),
+						measure_wheel(deadlines, start, std::chrono::milliseconds(1)),
+						measure_queue(deadlines, start, step));
+		}
+	}
+	return 0;
+}
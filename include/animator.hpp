@@ -0,0 +1,388 @@
+#ifndef CUI_SFML_ANIMATOR_HPP
+#define CUI_SFML_ANIMATOR_HPP
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <aliases.hpp>
+#include <cui/data_types/color.hpp>
+#include <cui/visual/scene_graph.hpp>
+#include <detail/intermediaries/color.hpp>
+#include <render_cache.hpp>
+#include <visual_element.hpp>
+
+namespace cui {
+
+namespace easing {
+
+using easing_t = float (*)(float);
+
+auto linear(const float t) noexcept -> float {
+	return t;
+}
+
+auto quad_in(const float t) noexcept -> float {
+	return t * t;
+}
+
+auto quad_out(const float t) noexcept -> float {
+	return t * (2 - t);
+}
+
+auto quad_in_out(const float t) noexcept -> float {
+	return t < 0.5f ? 2 * t * t : -1 + (4 - 2 * t) * t;
+}
+
+auto cubic_in(const float t) noexcept -> float {
+	return t * t * t;
+}
+
+auto cubic_out(const float t) noexcept -> float {
+	const auto u = t - 1;
+	return u * u * u + 1;
+}
+
+auto cubic_in_out(const float t) noexcept -> float {
+	return t < 0.5f ? 4 * t * t * t : (t - 1) * (2 * t - 2) * (2 * t - 2) + 1;
+}
+
+auto sine_in_out(const float t) noexcept -> float {
+	return -(std::cos(3.14159265f * t) - 1) / 2;
+}
+
+auto back_out(const float t) noexcept -> float {
+	constexpr float c1 = 1.70158f;
+	constexpr float c3 = c1 + 1;
+	const auto u = t - 1;
+	return 1 + c3 * u * u * u + c1 * u * u;
+}
+
+}	 // namespace easing
+
+/// \brief Interpolates node attributes over time
+/// \details Every animation targets one \sa cui::VisualAttribute of a node and writes the interpolated value
+/// into the active \sa cui::Schematic of the node, so the value survives later cache updates. Each advance
+/// collects the nodes it touched together with a mask of the changed attributes, which lets
+/// \sa RenderCache::update_attributes() refresh only those nodes. Animating an attribute that is driven by a
+/// rule replaces the rule with the absolute value the animation produces. Starting an animation on an
+/// attribute that is already animated replaces the running animation and continues from the current value.
+/// Animations address nodes by index, so the animator is bound to the graph of its animations. Animating or
+/// advancing on another graph, eg. after the active scene changed, drops the animations of the previous one
+class Animator
+{
+public:
+	using steady_clock_t = std::chrono::steady_clock;
+	using standard_duration_t = steady_clock_t::duration;
+	using time_point_t = steady_clock_t::time_point;
+	using animation_id_t = u64;
+	using easing_t = easing::easing_t;
+	using finish_t = std::function<void()>;
+	using value_t = std::array<float, 4>;
+	using size_type = std::size_t;
+
+	static constexpr animation_id_t invalid_id = 0;
+
+	struct Animation
+	{
+		animation_id_t id;
+		size_type node_index;
+		VisualAttribute attribute;
+		value_t from;
+		value_t to;
+		time_point_t start;
+		standard_duration_t duration;
+		easing_t easing;
+		finish_t on_finish;
+	};
+
+	struct DirtyNode
+	{
+		size_type node_index;
+		visual_attributes_t attributes;
+	};
+
+	auto animate(SceneGraph& graph,
+				 const RenderCache& cache,
+				 size_type node_index,
+				 VisualAttribute attribute,
+				 const value_t& to,
+				 standard_duration_t duration,
+				 easing_t easing,
+				 finish_t&& on_finish,
+				 time_point_t now) -> animation_id_t;
+
+	bool cancel(animation_id_t id) noexcept;
+
+	auto cancel_node(size_type node_index) noexcept -> size_type;
+
+	void advance(SceneGraph& graph, time_point_t now);
+
+	void run_finished();
+
+	void apply_remap(const SceneGraph::remap_t& remap);
+
+	void clear() noexcept;
+
+	[[nodiscard]] auto dirty_nodes() const noexcept -> const std::vector<DirtyNode>& {
+		return dirty_;
+	}
+
+	[[nodiscard]] auto size() const noexcept -> size_type {
+		return animations_.size();
+	}
+
+	[[nodiscard]] bool empty() const noexcept {
+		return animations_.empty();
+	}
+
+	[[nodiscard]] static auto numeric(float value) noexcept -> value_t {
+		return {value, 0, 0, 0};
+	}
+
+	[[nodiscard]] static auto color(const Color& value) noexcept -> value_t {
+		return {static_cast<float>(value.red()), static_cast<float>(value.green()), static_cast<float>(value.blue()), static_cast<float>(value.alpha())};
+	}
+
+	static void apply(Schematic& scheme, VisualAttribute attribute, const value_t& value);
+
+private:
+	[[nodiscard]] static auto current_value(const Schematic& scheme, const VisualElement& ve, VisualAttribute attribute) -> value_t;
+	void mark_dirty(size_type node_index, VisualAttribute attribute);
+	void bind(const SceneGraph& graph) noexcept;
+
+	const SceneGraph* graph_ = nullptr;
+	std::vector<Animation> animations_;
+	std::vector<DirtyNode> dirty_;
+	std::vector<visual_attributes_t> dirty_masks_;
+	std::vector<finish_t> finished_;
+	animation_id_t next_id_ = 1;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Starts animating an attribute of a node
+/// \param graph The graph the node belongs to
+/// \param cache The cache holding the current \sa cui::VisualElement of the node
+/// \param node_index The index of the node in the \sa cui::SceneGraph nodes vector
+/// \param attribute The attribute to animate
+/// \param to The target value, see \sa Animator::numeric() and \sa Animator::color()
+/// \param duration The duration of the animation
+/// \param easing The easing curve applied to the progress
+/// \param on_finish Optional callback invoked once the animation reached its target
+/// \param now The start time of the animation
+/// \returns The id used to cancel the animation
+auto Animator::animate(SceneGraph& graph,
+					   const RenderCache& cache,
+					   const size_type node_index,
+					   const VisualAttribute attribute,
+					   const value_t& to,
+					   const standard_duration_t duration,
+					   const easing_t easing,
+					   finish_t&& on_finish,
+					   const time_point_t now) -> animation_id_t {
+	this->bind(graph);
+	const auto& scheme = std::as_const(graph[node_index].data()).active_schematic();
+	const auto from = current_value(scheme, cache[node_index + 1], attribute);
+
+	animations_.erase(std::remove_if(animations_.begin(),
+									 animations_.end(),
+									 [&](const Animation& a) { return a.node_index == node_index && a.attribute == attribute; }),
+					  animations_.end());
+
+	const auto id = next_id_++;
+	animations_.push_back(Animation{id, node_index, attribute, from, to, now, duration, easing ? easing : easing::linear, std::move(on_finish)});
+	return id;
+}
+
+/// \brief Stops an animation, leaving the attribute at its current value
+/// \param id The id returned by \sa Animator::animate()
+/// \returns A boolean indicating whether the animation was still running
+bool Animator::cancel(const animation_id_t id) noexcept {
+	const auto it = std::find_if(animations_.begin(), animations_.end(), [id](const Animation& a) { return a.id == id; });
+	if (it == animations_.end()) return false;
+
+	animations_.erase(it);
+	return true;
+}
+
+/// \brief Stops every animation of a node
+/// \param node_index The index of the node in the \sa cui::SceneGraph nodes vector
+/// \returns The amount of stopped animations
+auto Animator::cancel_node(const size_type node_index) noexcept -> size_type {
+	const auto size = animations_.size();
+	animations_.erase(
+	  std::remove_if(animations_.begin(), animations_.end(), [node_index](const Animation& a) { return a.node_index == node_index; }),
+	  animations_.end());
+	return size - animations_.size();
+}
+
+/// \brief Advances every animation to a point in time
+/// \details Writes the interpolated values into the schematics and records the touched nodes in
+/// \sa Animator::dirty_nodes(). Finished animations are removed, their callbacks run on
+/// \sa Animator::run_finished() once the cache caught up
+/// \param graph The graph the animated nodes belong to
+/// \param now The frame time
+void Animator::advance(SceneGraph& graph, const time_point_t now) {
+	this->bind(graph);
+	for (const auto& [node_index, _] : dirty_) dirty_masks_[node_index] = 0;
+	dirty_.clear();
+	if (dirty_masks_.size() < graph.length()) dirty_masks_.resize(graph.length(), 0);
+
+	auto it = animations_.begin();
+	while (it != animations_.end()) {
+		auto& animation = *it;
+		const auto elapsed = now - animation.start;
+		const auto finished = elapsed >= animation.duration;
+		const auto t = finished ? 1.0f : std::max(0.0f, std::chrono::duration<float>(elapsed) / std::chrono::duration<float>(animation.duration));
+		const auto eased = finished ? 1.0f : animation.easing(t);
+
+		value_t value;
+		for (size_type i = 0; i < value.size(); ++i) value[i] = animation.from[i] + (animation.to[i] - animation.from[i]) * eased;
+
+		apply(graph[animation.node_index].data().active_schematic().get(), animation.attribute, value);
+		mark_dirty(animation.node_index, animation.attribute);
+
+		if (!finished) {
+			++it;
+			continue;
+		}
+
+		if (animation.on_finish) finished_.push_back(std::move(animation.on_finish));
+		it = animations_.erase(it);
+	}
+
+	for (auto& [node_index, attributes] : dirty_) attributes = dirty_masks_[node_index];
+}
+
+/// \brief Runs the callbacks of the animations that finished during the last advance
+/// \details The callbacks may start new animations
+void Animator::run_finished() {
+	if (finished_.empty()) return;
+
+	auto finished = std::move(finished_);
+	finished_.clear();
+	for (auto& callback : finished) callback();
+}
+
+/// \brief Follows a structural change of the graph
+/// \details Animations of removed nodes are dropped without running their callbacks, the others move to the
+/// new node indices
+/// \param remap The remap returned by \sa SceneGraph::insert_subtree() or \sa SceneGraph::remove_subtree()
+void Animator::apply_remap(const SceneGraph::remap_t& remap) {
+	if (remap.empty()) return;
+
+	for (const auto& [node_index, _] : dirty_) dirty_masks_[node_index] = 0;
+	dirty_.clear();
+
+	animations_.erase(std::remove_if(animations_.begin(),
+									 animations_.end(),
+									 [&remap](Animation& a) {
+										 a.node_index = remap.map(a.node_index);
+										 return a.node_index == SceneGraph::remap_t::npos;
+									 }),
+					  animations_.end());
+}
+
+/// \brief Stops every animation without running its callback
+/// \details Callbacks of animations that already finished still run on \sa Animator::run_finished()
+void Animator::clear() noexcept {
+	for (const auto& [node_index, _] : dirty_) dirty_masks_[node_index] = 0;
+	dirty_.clear();
+	animations_.clear();
+}
+
+/// \brief Binds the animator to the graph of the animations it is about to run
+/// \details The animations of a previously bound graph are dropped, their node indices mean nothing in another one
+/// \param graph The graph of the active scene
+void Animator::bind(const SceneGraph& graph) noexcept {
+	if (graph_ == &graph) return;
+
+	this->clear();
+	graph_ = &graph;
+}
+
+/// \brief Reads the value an animation starts from
+/// \details Rule driven and non-color attributes are read from the \sa cui::VisualElement instead of the schematic
+auto Animator::current_value(const Schematic& scheme, const VisualElement& ve, const VisualAttribute attribute) -> value_t {
+	switch (attribute) {
+		case VisualAttribute::X: {
+			return numeric(!scheme.x_rule() && scheme.x().is_int() ? static_cast<float>(scheme.x().integer_value()) : ve.getPosition().x);
+		}
+		case VisualAttribute::Y: {
+			return numeric(!scheme.y_rule() && scheme.y().is_int() ? static_cast<float>(scheme.y().integer_value()) : ve.getPosition().y);
+		}
+		case VisualAttribute::Width: {
+			return numeric(!scheme.width_rule() && scheme.width().is_int() ? static_cast<float>(scheme.width().integer_value()) : ve.getSize().x);
+		}
+		case VisualAttribute::Height: {
+			return numeric(!scheme.height_rule() && scheme.height().is_int() ? static_cast<float>(scheme.height().integer_value()) : ve.getSize().y);
+		}
+		case VisualAttribute::Background: {
+			return color(scheme.background().is_rgba() ? scheme.background().rgba() : Color(intermediary::Color{ve.getFillColor()}));
+		}
+		case VisualAttribute::TextColor: {
+			return color(scheme.text_color().is_rgba() ? scheme.text_color().rgba() : Color(intermediary::Color{ve.text().getFillColor()}));
+		}
+		case VisualAttribute::Text: {
+			break;
+		}
+	}
+	return {};
+}
+
+/// \brief Writes a value into a schematic
+/// \details Numeric attributes are rounded to whole pixels and replace a rule driving the attribute
+void Animator::apply(Schematic& scheme, const VisualAttribute attribute, const value_t& value) {
+	const auto to_int = [](const float v) { return static_cast<int>(std::lround(v)); };
+	const auto to_color = [&to_int](const value_t& v) { return Color(to_int(v[0]), to_int(v[1]), to_int(v[2]), to_int(v[3])); };
+
+	switch (attribute) {
+		case VisualAttribute::X: {
+			scheme.x() = to_int(value[0]);
+			scheme.set_x_rule(false);
+			break;
+		}
+		case VisualAttribute::Y: {
+			scheme.y() = to_int(value[0]);
+			scheme.set_y_rule(false);
+			break;
+		}
+		case VisualAttribute::Width: {
+			scheme.width() = to_int(value[0]);
+			scheme.set_width_rule(false);
+			break;
+		}
+		case VisualAttribute::Height: {
+			scheme.height() = to_int(value[0]);
+			scheme.set_height_rule(false);
+			break;
+		}
+		case VisualAttribute::Background: {
+			scheme.background() = to_color(value);
+			break;
+		}
+		case VisualAttribute::TextColor: {
+			scheme.text_color() = to_color(value);
+			break;
+		}
+		case VisualAttribute::Text: {
+			break;
+		}
+	}
+}
+
+/// \brief Adds an attribute to the dirty mask of a node
+void Animator::mark_dirty(const size_type node_index, const VisualAttribute attribute) {
+	auto& mask = dirty_masks_[node_index];
+	if (mask == 0) dirty_.push_back(DirtyNode{node_index, 0});
+	mask |= attribute_bit(attribute);
+}
+
+}	 // namespace cui
+
+#endif	  // CUI_SFML_ANIMATOR_HPP
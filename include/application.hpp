@@ -0,0 +1,246 @@
+#ifndef CUI_SFML_APPLICATION_HPP
+#define CUI_SFML_APPLICATION_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <aliases.hpp>
+#include <detail/clock.hpp>
+#include <detail/worker_pool.hpp>
+#include <window.hpp>
+#include <window_options.hpp>
+
+namespace cui {
+
+/// \brief Drives any amount of windows from a single loop on the calling thread
+/// \details Every window added shares the worker pool and the timer sleep of the application instead of
+/// spawning a window thread and a timer thread of its own, so the thread count and the idle wake-ups stay
+/// constant as windows are added. Each window keeps its own timer wheel, its timers and posted UI mutations
+/// still run on the loop thread. Windows must outlive the application and have to be added on the thread
+/// that calls \sa Application::run()
+class Application
+{
+public:
+	using size_type = std::size_t;
+	using steady_clock_t = std::chrono::steady_clock;
+	using standard_duration_t = steady_clock_t::duration;
+	using time_point_t = steady_clock_t::time_point;
+
+	enum class RenderPolicy : u8
+	{
+		WhenDirty,
+		RoundRobin
+	};
+
+	explicit Application(size_type worker_count = 0, RenderPolicy policy = RenderPolicy::WhenDirty);
+
+	Application(const Application&) = delete;
+	auto operator=(const Application&) -> Application& = delete;
+
+	~Application();
+
+	void add(Window& window, const WindowOptions& options);
+
+	void run(u32 framerate);
+
+	void stop();
+
+	[[nodiscard]] auto windows() const noexcept -> const std::vector<Window*>& {
+		return windows_;
+	}
+
+	[[nodiscard]] auto workers() noexcept -> std::shared_ptr<WorkerPool>& {
+		return workers_;
+	}
+
+	[[nodiscard]] auto render_policy() noexcept -> RenderPolicy& {
+		return policy_;
+	}
+
+	[[nodiscard]] auto frame_count() const noexcept -> u64 {
+		return frame_count_;
+	}
+
+	[[nodiscard]] auto render_count() const noexcept -> u64 {
+		return render_count_;
+	}
+
+	/// \brief The clock pacing the frames of the loop, the timers of each window run on the clock of that window
+	[[nodiscard]] auto clock() noexcept -> Clock& {
+		return clock_;
+	}
+
+	[[nodiscard]] auto clock() const noexcept -> const Clock& {
+		return clock_;
+	}
+
+	/// \brief The longest sleep of the idle loop without a framerate limit, bounds the delay of new input
+	[[nodiscard]] auto idle_poll_interval() noexcept -> standard_duration_t& {
+		return idle_poll_interval_;
+	}
+
+	[[nodiscard]] auto idle_poll_interval() const noexcept -> standard_duration_t {
+		return idle_poll_interval_;
+	}
+
+private:
+	void render_windows();
+	void wait(time_point_t next_frame);
+
+	std::vector<Window*> windows_;
+	std::shared_ptr<WorkerPool> workers_;
+	std::shared_ptr<Window::TimerSignal> signal_ = std::make_shared<Window::TimerSignal>();
+	Clock clock_;
+	standard_duration_t idle_poll_interval_ = std::chrono::milliseconds(4);
+	RenderPolicy policy_;
+	size_type next_render_ = 0;
+	u64 frame_count_ = 0;
+	u64 render_count_ = 0;
+	std::atomic<bool> stopping_ = false;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Spawns the shared worker pool
+/// \param worker_count The amount of worker threads, zero picks \sa WorkerPool::default_worker_count()
+/// \param policy Decides which windows are rendered on a frame
+Application::Application(const size_type worker_count, const RenderPolicy policy)
+	: workers_(std::make_shared<WorkerPool>(worker_count == 0 ? WorkerPool::default_worker_count() : worker_count)), policy_(policy) {}
+
+/// \brief Stops the worker pool while the windows its tasks refer to are still alive
+Application::~Application() {
+	workers_->stop();
+}
+
+/// \brief Creates the \sa sf::RenderWindow of a window and hands it to the loop
+/// \details The framerate, worker count, inline timer and pipelining options are ignored, see
+/// \sa Window::init_shared(). Adding a window while the loop runs is only allowed from the loop thread,
+/// eg. inside an event
+/// \param window The window to drive
+/// \param options The options with which to construct the \sa sf::RenderWindow
+void Application::add(Window& window, const WindowOptions& options) {
+	window.init_shared(options, workers_, signal_);
+	windows_.push_back(&window);
+}
+
+/// \brief Runs every window until all of them closed or \sa Application::stop() is called
+/// \details Every iteration polls the events, posted mutations and due timers of each window. At each frame
+/// boundary the animations of every window advance and windows are rendered according to the render policy.
+/// In between, the loop sleeps until the next frame or the earliest timer deadline of any window, whichever
+/// comes first. Timers scheduled and UI mutations posted from other threads wake it early. Without a limit,
+/// frames run back to back only while a window has pending work, see \sa Window::has_pending_work(), and the
+/// idle loop polls the windows for input every \sa Application::idle_poll_interval(). Frames are paced on
+/// \sa Application::clock()
+/// \param framerate The frame limit, zero for no limit
+void Application::run(const u32 framerate) {
+	const auto frame_interval = framerate == 0 ? standard_duration_t::zero()
+											   : std::chrono::duration_cast<standard_duration_t>(std::chrono::seconds(1)) / framerate;
+	const auto uncapped = frame_interval == standard_duration_t::zero();
+	auto next_frame = clock_.now();
+
+	while (!stopping_.load(std::memory_order_acquire)) {
+		const auto running = std::any_of(windows_.begin(), windows_.end(), [](Window* w) { return w->is_running(); });
+		if (!running) break;
+
+		for (size_type i = 0; i < windows_.size(); ++i) {
+			auto& window = *windows_[i];
+			if (!window.is_running()) continue;
+			window.apply_ui_tasks();
+			window.apply_ui_commands();
+			window.handle_events();
+			window.run_due_timers();
+		}
+
+		const auto now = clock_.now();
+		if (uncapped) {
+			const auto busy = std::any_of(windows_.begin(), windows_.end(), [](Window* w) { return w->is_running() && w->has_pending_work(); });
+			if (!busy) {
+				this->wait(now + idle_poll_interval_);
+				continue;
+			}
+		}
+
+		if (now >= next_frame) {
+			this->render_windows();
+			++frame_count_;
+			next_frame += frame_interval;
+			if (next_frame < now) next_frame = now + frame_interval;
+		}
+
+		if (!uncapped) this->wait(next_frame);
+	}
+}
+
+/// \brief Makes \sa Application::run() return after the current iteration
+/// \details Safe to call from any thread, the windows stay open
+void Application::stop() {
+	stopping_.store(true, std::memory_order_release);
+
+	std::unique_lock lock(signal_->mutex);
+	signal_->awakened = true;
+	signal_->cv.notify_one();
+}
+
+/// \brief Advances the animations and virtual lists of every window and renders them according to the render policy
+/// \details WhenDirty renders every window whose frame changed or received input. RoundRobin renders a single
+/// window per frame regardless of its state, cycling through the open windows
+void Application::render_windows() {
+	for (auto* window : windows_) {
+		if (!window->is_running()) continue;
+		window->run_animations();
+		window->run_virtual_lists();
+	}
+
+	if (policy_ == RenderPolicy::WhenDirty) {
+		for (auto* window : windows_) {
+			if (!window->is_running() || !window->needs_render()) continue;
+			window->render();
+			++render_count_;
+		}
+		return;
+	}
+
+	for (size_type attempt = 0; attempt < windows_.size(); ++attempt) {
+		auto& window = *windows_[next_render_++ % windows_.size()];
+		if (!window.is_running()) continue;
+		window.render();
+		++render_count_;
+		return;
+	}
+}
+
+/// \brief Sleeps until the next frame, the earliest timer deadline of any window, a newly scheduled timer or a
+/// posted UI mutation
+/// \details Follows the protocol of \sa Window::frame_wait() for every window at once: all submissions are
+/// merged, the wake time is published to each window and the sleep is skipped if any submission or post raced
+/// with it. Timer deadlines are measured on the clock of their window and the frame on the application clock
+/// \param next_frame The time the next frame is due on \sa Application::clock()
+void Application::wait(const time_point_t next_frame) {
+	std::unique_lock lock(signal_->mutex);
+	auto sleep = next_frame - clock_.now();
+	for (auto* window : windows_) {
+		window->merge_submitted_timers();
+		if (const auto deadline = window->timers_.next_deadline()) sleep = std::min(sleep, *deadline - window->clock_.now());
+	}
+
+	auto may_sleep = true;
+	for (auto* window : windows_) {
+		may_sleep = window->publish_timer_wait(window->clock_.now() + sleep) && may_sleep;
+		may_sleep = !window->has_posted_work() && may_sleep;
+	}
+	if (may_sleep && !stopping_.load(std::memory_order_acquire)) {
+		signal_->cv.wait_for(lock, sleep, [this] { return signal_->awakened; });
+	}
+
+	for (auto* window : windows_) window->timer_wake_at_.store(std::numeric_limits<standard_duration_t::rep>::min());
+	signal_->awakened = false;
+}
+
+}	 // namespace cui
+
+#endif	  // CUI_SFML_APPLICATION_HPP
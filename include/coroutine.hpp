@@ -0,0 +1,152 @@
+#ifndef CUI_SFML_COROUTINE_HPP
+#define CUI_SFML_COROUTINE_HPP
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#define CUI_HAS_COROUTINES 1
+#endif
+
+#ifdef CUI_HAS_COROUTINES
+
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace cui {
+
+/// \brief Fire-and-forget coroutine type for event handlers
+/// \details Starts running as soon as it is called and destroys its frame when it finishes. A handler that
+/// returns a \sa cui::Task can be registered as a regular event. Parameters should be taken by value, the
+/// frame outlives the dispatch that started it. Exceptions propagate to whoever resumed the coroutine,
+/// which is the frame loop for every step after the first suspension. Coroutines still suspended when the
+/// window closes are never resumed
+class Task
+{
+public:
+	struct promise_type
+	{
+		auto get_return_object() noexcept -> Task {
+			return {};
+		}
+
+		auto initial_suspend() noexcept -> std::suspend_never {
+			return {};
+		}
+
+		auto final_suspend() noexcept -> std::suspend_never {
+			return {};
+		}
+
+		void return_void() noexcept {}
+
+		void unhandled_exception() {
+			throw;
+		}
+	};
+};
+
+namespace detail {
+
+/// \brief Resumes the awaiting coroutine on the window thread once a duration elapsed
+/// \details Goes through the timer wheel without a \sa cui::TimerHandle, the resumption only stores the
+/// coroutine handle so it does not allocate
+template <typename Owner>
+class DelayAwaiter
+{
+public:
+	using standard_duration_t = std::chrono::steady_clock::duration;
+
+	DelayAwaiter(Owner& p_owner, const standard_duration_t p_duration) : owner_(p_owner), duration_(p_duration) {}
+
+	[[nodiscard]] bool await_ready() const noexcept {
+		return duration_ <= standard_duration_t::zero();
+	}
+
+	void await_suspend(std::coroutine_handle<> handle) {
+		owner_.timer_submit(typename Owner::timer_event_t([handle] { handle.resume(); }, owner_.clock().now() + duration_));
+	}
+
+	void await_resume() const noexcept {}
+
+private:
+	Owner& owner_;
+	standard_duration_t duration_;
+};
+
+/// \brief Resumes the awaiting coroutine at the start of the next frame
+template <typename Owner>
+class NextFrameAwaiter
+{
+public:
+	explicit NextFrameAwaiter(Owner& p_owner) : owner_(p_owner) {}
+
+	[[nodiscard]] bool await_ready() const noexcept {
+		return false;
+	}
+
+	void await_suspend(std::coroutine_handle<> handle) {
+		owner_.post_to_ui([handle] { handle.resume(); });
+	}
+
+	void await_resume() const noexcept {}
+
+private:
+	Owner& owner_;
+};
+
+/// \brief Runs a job on the worker pool and resumes the awaiting coroutine on the window thread with its result
+/// \details The job and its result live inside the awaiter, which lives in the coroutine frame. An exception
+/// thrown by the job is rethrown on the window thread
+template <typename Owner, typename Job>
+class WorkerAwaiter
+{
+public:
+	using result_t = std::invoke_result_t<Job&>;
+	using storage_t = std::conditional_t<std::is_void_v<result_t>, bool, std::optional<result_t>>;
+
+	WorkerAwaiter(Owner& p_owner, Job&& p_job) : owner_(p_owner), job_(std::move(p_job)) {}
+
+	[[nodiscard]] bool await_ready() const noexcept {
+		return false;
+	}
+
+	void await_suspend(std::coroutine_handle<> handle) {
+		auto& workers = owner_.workers();
+		if (!workers) throw std::logic_error("The window has not been initialized");
+
+		workers->submit([this, handle] {
+			try {
+				if constexpr (std::is_void_v<result_t>) {
+					job_();
+				} else {
+					result_.emplace(job_());
+				}
+			} catch (...) {
+				exception_ = std::current_exception();
+			}
+			owner_.post_to_ui([handle] { handle.resume(); });
+		});
+	}
+
+	auto await_resume() -> result_t {
+		if (exception_) std::rethrow_exception(exception_);
+		if constexpr (!std::is_void_v<result_t>) return std::move(*result_);
+	}
+
+private:
+	Owner& owner_;
+	Job job_;
+	storage_t result_{};
+	std::exception_ptr exception_;
+};
+
+}	 // namespace detail
+
+}	 // namespace cui
+
+#endif	  // CUI_HAS_COROUTINES
+
+#endif	  // CUI_SFML_COROUTINE_HPP
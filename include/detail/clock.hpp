@@ -0,0 +1,67 @@
+#ifndef CUI_SFML_CLOCK_HPP
+#define CUI_SFML_CLOCK_HPP
+
+#include <atomic>
+#include <chrono>
+
+namespace cui {
+
+/// \brief The time source of a window
+/// \details Reads \sa std::chrono::steady_clock by default. In virtual mode it reports a stored time point
+/// that only moves when advanced, which makes the frame loop, timers and animations deterministic.
+/// Virtual time points are steady_clock time points, so switching modes does not invalidate deadlines.
+/// Reading and advancing is safe from any thread
+class Clock
+{
+public:
+	using steady_clock_t = std::chrono::steady_clock;
+	using standard_duration_t = steady_clock_t::duration;
+	using time_point_t = steady_clock_t::time_point;
+
+	[[nodiscard]] auto now() const noexcept -> time_point_t {
+		if (!virtual_.load(std::memory_order_acquire)) return steady_clock_t::now();
+		return time_point_t(standard_duration_t(virtual_now_.load(std::memory_order_acquire)));
+	}
+
+	[[nodiscard]] bool is_virtual() const noexcept {
+		return virtual_.load(std::memory_order_acquire);
+	}
+
+	/// \brief Switches to virtual time
+	/// \param start The time point virtual time starts at, never earlier than the current time
+	void use_virtual(const time_point_t start = steady_clock_t::now()) noexcept {
+		const auto current = now();
+		virtual_now_.store((start < current ? current : start).time_since_epoch().count(), std::memory_order_release);
+		virtual_.store(true, std::memory_order_release);
+	}
+
+	/// \brief Switches back to real time
+	/// \details Virtual time that ran ahead of real time is not carried over
+	void use_real() noexcept {
+		virtual_.store(false, std::memory_order_release);
+	}
+
+	/// \brief Moves virtual time forward, does nothing in real mode
+	/// \param duration The duration to advance by, negative durations are ignored
+	void advance(const standard_duration_t duration) noexcept {
+		if (duration <= standard_duration_t::zero() || !is_virtual()) return;
+		virtual_now_.fetch_add(duration.count(), std::memory_order_acq_rel);
+	}
+
+	/// \brief Moves virtual time forward to a time point, does nothing in real mode or if it already passed
+	/// \param time The time point to advance to
+	void advance_to(const time_point_t time) noexcept {
+		if (!is_virtual()) return;
+		auto current = virtual_now_.load(std::memory_order_acquire);
+		const auto target = time.time_since_epoch().count();
+		while (current < target && !virtual_now_.compare_exchange_weak(current, target, std::memory_order_acq_rel)) {}
+	}
+
+private:
+	std::atomic<bool> virtual_{false};
+	std::atomic<standard_duration_t::rep> virtual_now_{0};
+};
+
+}	 // namespace cui
+
+#endif	  // CUI_SFML_CLOCK_HPP
@@ -1,10 +1,12 @@
 #ifndef CUI_SFML_EVENT_DATA_HPP
 #define CUI_SFML_EVENT_DATA_HPP
 
+#include <string>
 #include <string_view>
 #include <variant>
 
 #include <SFML/Window/Event.hpp>
+#include <aliases.hpp>
 #include <cui/visual/node.hpp>
 
 namespace cui {
@@ -32,13 +34,16 @@ public:
 										sf::Event::TouchEvent,
 										sf::Event::SensorEvent>;
 
-	EventData() : data_(Empty{}), caller_(nullptr), caller_index_(-1) {}
+	EventData() : data_(Empty{}), caller_(nullptr), caller_index_(-1), target_index_(-1) {}
 	template <typename TData>
 	EventData(const TData& p_data, std::string_view p_name)
-		: data_(p_data), caller_(nullptr), caller_index_(-1), event_name_(p_name) {}
+		: data_(p_data), caller_(nullptr), caller_index_(-1), target_index_(-1), event_name_(p_name) {}
 	template <typename TData>
 	EventData(const TData& p_data, node_t* p_caller, size_type p_index, std::string_view p_name)
-		: data_(p_data), caller_(p_caller), caller_index_(p_index), event_name_(p_name) {}
+		: data_(p_data), caller_(p_caller), caller_index_(p_index), target_index_(p_index), event_name_(p_name) {}
+	template <typename TData>
+	EventData(const TData& p_data, node_t* p_caller, size_type p_index, size_type p_target_index, std::string_view p_name)
+		: data_(p_data), caller_(p_caller), caller_index_(p_index), target_index_(p_target_index), event_name_(p_name) {}
 
 	[[nodiscard]] auto get() noexcept -> data_variant_t& {
 		return data_;
@@ -64,6 +69,16 @@ public:
 		return caller_index_;
 	}
 
+	/// \brief Index of the node the event was targeted at
+	/// \details Equal to the caller index, except for delegated events where the caller is the delegating ancestor
+	[[nodiscard]] auto target_index() const noexcept -> size_type {
+		return target_index_;
+	}
+
+	[[nodiscard]] bool is_delegated() const noexcept {
+		return target_index_ != caller_index_;
+	}
+
 	[[nodiscard]] auto event_name() const noexcept -> std::string_view {
 		return event_name_;
 	}
@@ -80,9 +95,79 @@ private:
 	data_variant_t data_;
 	node_t* caller_;
 	size_type caller_index_;
+	size_type target_index_;
 	std::string_view event_name_;
 };
 
+/// \brief An owned copy of \sa cui::EventData that stays valid after the dispatch returns
+/// \details Keeps the names of the caller and of the event instead of a pointer and a view into the scene graph,
+/// together with the graph generation the indices were taken at. Handed to async handlers on a worker thread,
+/// where the graph must not be touched; the caller is looked up again on the UI thread, see \sa Window::resolve_caller()
+template <typename TNode>
+class EventSnapshot
+{
+public:
+	using event_data_t = EventData<TNode>;
+	using size_type = typename event_data_t::size_type;
+	using data_variant_t = typename event_data_t::data_variant_t;
+
+	EventSnapshot() : caller_index_(-1), target_index_(-1), generation_(0), has_caller_(false) {}
+	EventSnapshot(const event_data_t& p_data, const u64 p_generation)
+		: data_(p_data.get()),
+		  caller_name_(p_data.has_caller() ? p_data.caller()->name() : std::string()),
+		  event_name_(p_data.event_name()),
+		  caller_index_(p_data.caller_index()),
+		  target_index_(p_data.target_index()),
+		  generation_(p_generation),
+		  has_caller_(p_data.has_caller()) {}
+
+	[[nodiscard]] auto get() const noexcept -> const data_variant_t& {
+		return data_;
+	}
+
+	[[nodiscard]] auto caller_name() const noexcept -> const std::string& {
+		return caller_name_;
+	}
+
+	[[nodiscard]] auto caller_index() const noexcept -> size_type {
+		return caller_index_;
+	}
+
+	[[nodiscard]] auto target_index() const noexcept -> size_type {
+		return target_index_;
+	}
+
+	[[nodiscard]] bool is_delegated() const noexcept {
+		return target_index_ != caller_index_;
+	}
+
+	[[nodiscard]] auto event_name() const noexcept -> const std::string& {
+		return event_name_;
+	}
+
+	/// \brief The generation of the scene graph the indices refer to, see \sa SceneGraph::generation()
+	[[nodiscard]] auto generation() const noexcept -> u64 {
+		return generation_;
+	}
+
+	[[nodiscard]] bool has_caller() const noexcept {
+		return has_caller_;
+	}
+
+	[[nodiscard]] bool empty() const noexcept {
+		return data_.index() == 0;
+	}
+
+private:
+	data_variant_t data_;
+	std::string caller_name_;
+	std::string event_name_;
+	size_type caller_index_;
+	size_type target_index_;
+	u64 generation_;
+	bool has_caller_;
+};
+
 }	 // namespace cui
 
 #endif	  // CUI_SFML_EVENT_DATA_HPP
\ No newline at end of file
@@ -0,0 +1,142 @@
+#ifndef CUI_SFML_LATENCY_HISTOGRAM_HPP
+#define CUI_SFML_LATENCY_HISTOGRAM_HPP
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <limits>
+
+#include <aliases.hpp>
+
+namespace cui {
+
+/// \brief Log-linear histogram of nanosecond latencies in the style of an HDR histogram
+/// \details Values below 32ns are counted exactly. Above that every power of two range is split into
+/// 32 equal sub-buckets, which bounds the relative error of a reported percentile to about 3%.
+/// Values beyond roughly an hour are clamped into the last bucket, the exact maximum is kept aside.
+/// Recording is O(1) and never allocates
+class LatencyHistogram
+{
+public:
+	using duration_t = std::chrono::nanoseconds;
+	using size_type = std::size_t;
+
+	static constexpr u32 sub_bucket_bits = 5;
+	static constexpr u32 sub_bucket_count = 1u << sub_bucket_bits;
+	static constexpr u32 max_exponent = 41;
+	static constexpr size_type bucket_count = sub_bucket_count * (max_exponent - sub_bucket_bits + 2);
+
+	void record(duration_t latency) noexcept;
+
+	void merge(const LatencyHistogram& other) noexcept;
+
+	void reset() noexcept;
+
+	[[nodiscard]] auto percentile(double p) const noexcept -> duration_t;
+
+	[[nodiscard]] auto count() const noexcept -> u64 {
+		return count_;
+	}
+
+	[[nodiscard]] auto min() const noexcept -> duration_t {
+		return duration_t(count_ == 0 ? 0 : min_);
+	}
+
+	[[nodiscard]] auto max() const noexcept -> duration_t {
+		return duration_t(max_);
+	}
+
+	[[nodiscard]] auto mean() const noexcept -> duration_t {
+		return duration_t(count_ == 0 ? 0 : static_cast<u64>(sum_ / count_));
+	}
+
+	[[nodiscard]] auto p50() const noexcept -> duration_t {
+		return percentile(50.0);
+	}
+
+	[[nodiscard]] auto p99() const noexcept -> duration_t {
+		return percentile(99.0);
+	}
+
+private:
+	[[nodiscard]] static auto index_of(u64 value) noexcept -> size_type;
+	[[nodiscard]] static auto highest_value_of(size_type index) noexcept -> u64;
+
+	std::array<u64, bucket_count> buckets_{};
+	u64 count_ = 0;
+	u64 min_ = std::numeric_limits<u64>::max();
+	u64 max_ = 0;
+	long double sum_ = 0;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Records a single latency
+/// \details Negative latencies are recorded as zero
+/// \param latency The latency to record
+void LatencyHistogram::record(const duration_t latency) noexcept {
+	const auto value = latency.count() < 0 ? u64(0) : static_cast<u64>(latency.count());
+	++buckets_[index_of(value)];
+	++count_;
+	sum_ += static_cast<long double>(value);
+	min_ = std::min(min_, value);
+	max_ = std::max(max_, value);
+}
+
+/// \brief Adds the recorded latencies of another histogram
+/// \param other The histogram to merge
+void LatencyHistogram::merge(const LatencyHistogram& other) noexcept {
+	for (size_type i = 0; i < bucket_count; ++i) buckets_[i] += other.buckets_[i];
+	count_ += other.count_;
+	sum_ += other.sum_;
+	min_ = std::min(min_, other.min_);
+	max_ = std::max(max_, other.max_);
+}
+
+/// \brief Discards every recorded latency
+void LatencyHistogram::reset() noexcept {
+	*this = LatencyHistogram{};
+}
+
+/// \brief Gets the latency below or at which the given percentage of recorded latencies fall
+/// \details Reports the highest value equivalent to the bucket the percentile lands in, never more than the maximum
+/// \param p The percentile in the range [0, 100]
+/// \returns The latency or zero if nothing was recorded
+auto LatencyHistogram::percentile(const double p) const noexcept -> duration_t {
+	if (count_ == 0) return duration_t::zero();
+
+	const auto clamped = std::clamp(p, 0.0, 100.0);
+	const auto target = std::max<u64>(1, static_cast<u64>(clamped / 100.0 * static_cast<double>(count_) + 0.5));
+	u64 seen = 0;
+	for (size_type i = 0; i < bucket_count; ++i) {
+		seen += buckets_[i];
+		if (seen >= target) return duration_t(std::min(highest_value_of(i), max_));
+	}
+	return duration_t(max_);
+}
+
+/// \brief Maps a value to its bucket
+auto LatencyHistogram::index_of(const u64 value) noexcept -> size_type {
+	if (value < sub_bucket_count) return static_cast<size_type>(value);
+
+	u32 exponent = sub_bucket_bits;
+	while (exponent < max_exponent && (value >> (exponent + 1)) != 0) ++exponent;
+	if ((value >> (exponent + 1)) != 0) return bucket_count - 1;
+
+	const auto sub = (value >> (exponent - sub_bucket_bits)) - sub_bucket_count;
+	return sub_bucket_count * (exponent - sub_bucket_bits + 1) + static_cast<size_type>(sub);
+}
+
+/// \brief Maps a bucket to the highest value it contains
+auto LatencyHistogram::highest_value_of(const size_type index) noexcept -> u64 {
+	if (index < sub_bucket_count) return index;
+
+	const auto exponent = static_cast<u32>(index / sub_bucket_count) - 1 + sub_bucket_bits;
+	const auto sub = static_cast<u64>(index % sub_bucket_count);
+	const auto shift = exponent - sub_bucket_bits;
+	return ((sub_bucket_count + sub) << shift) + ((u64(1) << shift) - 1);
+}
+
+}	 // namespace cui
+
+#endif	  // CUI_SFML_LATENCY_HISTOGRAM_HPP
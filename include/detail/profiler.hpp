@@ -0,0 +1,229 @@
+#ifndef CUI_SFML_PROFILER_HPP
+#define CUI_SFML_PROFILER_HPP
+
+/// \brief Scoped frame phase instrumentation
+/// \details CUI_PROFILE_SCOPE(name) records the time until the end of the enclosing scope under a string
+/// literal or a name returned by \sa Profiler::intern(), CUI_PROFILE_SCOPE_DYNAMIC(name) under a runtime
+/// std::string, which is interned under a lock on every call. Hot paths intern their names once, eg. events
+/// at registration. Both expand to nothing unless CUI_ENABLE_PROFILER is defined, see \sa cui::Profiler
+#ifdef CUI_ENABLE_PROFILER
+#define CUI_PROFILE_CONCAT_IMPL(a, b) a##b
+#define CUI_PROFILE_CONCAT(a, b) CUI_PROFILE_CONCAT_IMPL(a, b)
+#define CUI_PROFILE_SCOPE(name) const ::cui::ProfileScope CUI_PROFILE_CONCAT(cui_profile_scope_, __LINE__)(name)
+#define CUI_PROFILE_SCOPE_DYNAMIC(name) \
+	const ::cui::ProfileScope CUI_PROFILE_CONCAT(cui_profile_scope_, __LINE__)(::cui::Profiler::instance().intern(name))
+#else
+#define CUI_PROFILE_SCOPE(name)
+#define CUI_PROFILE_SCOPE_DYNAMIC(name)
+#endif
+
+#ifdef CUI_ENABLE_PROFILER
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <aliases.hpp>
+
+namespace cui {
+
+/// \brief Process-wide ring buffer of timed scopes
+/// \details Recording is lock-free and never allocates: each sample claims a slot with a single fetch_add and
+/// publishes it through a per-slot sequence number. Once the buffer is full the oldest samples are overwritten.
+/// Samples can be exported as Chrome trace-event JSON, to be opened in chrome://tracing or Perfetto
+class Profiler
+{
+public:
+	using steady_clock_t = std::chrono::steady_clock;
+	using time_point_t = steady_clock_t::time_point;
+	using size_type = std::size_t;
+
+	static constexpr size_type capacity = 1u << 16;
+
+	struct Sample
+	{
+		const char* name;
+		u32 thread;
+		u64 start;
+		u64 duration;
+	};
+
+	[[nodiscard]] static auto instance() -> Profiler& {
+		static Profiler profiler;
+		return profiler;
+	}
+
+	void record(const char* name, time_point_t start, time_point_t end) noexcept;
+
+	[[nodiscard]] auto intern(const std::string& name) -> const char*;
+
+	[[nodiscard]] auto samples() const -> std::vector<Sample>;
+
+	bool write_chrome_trace(const std::string& path) const;
+
+	void clear() noexcept;
+
+	/// \brief Gets a small, stable id of the calling thread
+	[[nodiscard]] static auto thread_id() noexcept -> u32 {
+		static std::atomic<u32> next{1};
+		thread_local const u32 id = next.fetch_add(1, std::memory_order_relaxed);
+		return id;
+	}
+
+private:
+	struct Slot
+	{
+		std::atomic<u64> sequence{0};
+		std::atomic<const char*> name{nullptr};
+		std::atomic<u32> thread{0};
+		std::atomic<u64> start{0};
+		std::atomic<u64> duration{0};
+	};
+
+	Profiler() : epoch_(steady_clock_t::now()), slots_(std::make_unique<std::array<Slot, capacity>>()) {}
+
+	time_point_t epoch_;
+	std::unique_ptr<std::array<Slot, capacity>> slots_;
+	std::atomic<u64> write_index_{0};
+	std::mutex names_mutex_;
+	std::unordered_set<std::string> names_;
+};
+
+/// \brief Records the lifetime of a scope into the \sa cui::Profiler
+/// \details Gets the profiler before taking the start time, so the first scope does not start before the epoch
+class ProfileScope
+{
+public:
+	explicit ProfileScope(const char* p_name) : profiler_(Profiler::instance()), name_(p_name), start_(Profiler::steady_clock_t::now()) {}
+
+	ProfileScope(const ProfileScope&) = delete;
+	auto operator=(const ProfileScope&) -> ProfileScope& = delete;
+
+	~ProfileScope() {
+		profiler_.record(name_, start_, Profiler::steady_clock_t::now());
+	}
+
+private:
+	Profiler& profiler_;
+	const char* name_;
+	Profiler::time_point_t start_;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Records a single sample
+/// \details The slot is marked odd while it is written so a concurrent reader skips it. Starts before the epoch
+/// of the profiler are clamped to it
+/// \param name A string with static storage duration or one returned by \sa Profiler::intern()
+/// \param start The start of the scope
+/// \param end The end of the scope
+void Profiler::record(const char* name, const time_point_t start, const time_point_t end) noexcept {
+	const auto index = write_index_.fetch_add(1, std::memory_order_relaxed);
+	auto& slot = (*slots_)[index % capacity];
+	const auto sequence = (index + 1) * 2;
+
+	slot.sequence.store(sequence - 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.name.store(name, std::memory_order_relaxed);
+	slot.thread.store(thread_id(), std::memory_order_relaxed);
+	const auto offset = std::chrono::duration_cast<std::chrono::nanoseconds>(start - epoch_).count();
+	slot.start.store(offset > 0 ? static_cast<u64>(offset) : 0, std::memory_order_relaxed);
+	slot.duration.store(static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()), std::memory_order_relaxed);
+	slot.sequence.store(sequence, std::memory_order_release);
+}
+
+/// \brief Gets a stable copy of a runtime name
+/// \details Takes a lock, so dynamic scopes cost more than literal ones
+/// \param name The name to copy
+/// \returns A pointer valid for the lifetime of the process
+auto Profiler::intern(const std::string& name) -> const char* {
+	std::unique_lock lock(names_mutex_);
+	return names_.insert(name).first->c_str();
+}
+
+/// \brief Copies the samples currently held by the buffer, oldest first
+/// \details Samples that are being overwritten during the copy are skipped
+auto Profiler::samples() const -> std::vector<Sample> {
+	const auto end = write_index_.load(std::memory_order_acquire);
+	const auto begin = end > capacity ? end - capacity : 0;
+
+	std::vector<Sample> result;
+	result.reserve(end - begin);
+	for (auto index = begin; index < end; ++index) {
+		const auto& slot = (*slots_)[index % capacity];
+		const auto sequence = (index + 1) * 2;
+		if (slot.sequence.load(std::memory_order_acquire) != sequence) continue;
+
+		Sample sample{slot.name.load(std::memory_order_relaxed),
+					  slot.thread.load(std::memory_order_relaxed),
+					  slot.start.load(std::memory_order_relaxed),
+					  slot.duration.load(std::memory_order_relaxed)};
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot.sequence.load(std::memory_order_relaxed) != sequence) continue;
+		result.push_back(sample);
+	}
+	return result;
+}
+
+/// \brief Writes the samples as Chrome trace-event JSON
+/// \details Times are written in microseconds with a fixed nanosecond fraction, long traces keep their resolution
+/// \param path The path of the trace file
+/// \returns A boolean indicating whether the file could be written
+bool Profiler::write_chrome_trace(const std::string& path) const {
+	std::ofstream stream(path, std::ios::trunc);
+	if (!stream.is_open()) return false;
+
+	const auto escape = [&stream](const char* text) {
+		for (; *text != '\0'; ++text) {
+			const auto c = *text;
+			if (c == '"' || c == '\\') {
+				stream << '\\' << c;
+			} else if (static_cast<unsigned char>(c) < 0x20) {
+				stream << ' ';
+			} else {
+				stream << c;
+			}
+		}
+	};
+
+	const auto write_micros = [&stream](const u64 nanoseconds) {
+		stream << nanoseconds / 1000 << '.' << std::setw(3) << std::setfill('0') << nanoseconds % 1000;
+	};
+
+	stream << "{\"traceEvents\":[";
+	auto first = true;
+	for (const auto& sample : samples()) {
+		if (!first) stream << ',';
+		first = false;
+
+		stream << "\n{\"name\":\"";
+		escape(sample.name);
+		stream << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << sample.thread << ",\"ts\":";
+		write_micros(sample.start);
+		stream << ",\"dur\":";
+		write_micros(sample.duration);
+		stream << '}';
+	}
+	stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+	return static_cast<bool>(stream);
+}
+
+/// \brief Drops every recorded sample
+/// \details Must not race with recording threads
+void Profiler::clear() noexcept {
+	for (auto& slot : *slots_) slot.sequence.store(0, std::memory_order_relaxed);
+	write_index_.store(0, std::memory_order_release);
+}
+
+}	 // namespace cui
+
+#endif	  // CUI_ENABLE_PROFILER
+
+#endif	  // CUI_SFML_PROFILER_HPP
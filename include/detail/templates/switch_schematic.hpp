@@ -6,19 +6,13 @@
 namespace cui::templates {
 
 void SwitchToEventSchematic(Window& window, event_data_t& event_data) {
-	bool scene_changed = false;
-	auto& e_schemes = event_data.caller()->event_schematics();
-	for (auto it = e_schemes.begin(); it != e_schemes.end(); ++it) {
-		if (it.key() == event_data.event_name()) {
-			event_data.caller()->active_schematic() = it.value();
-			scene_changed = true;
-		}
-	}
-	if (scene_changed) window.schedule_to_update_cache();
+	const std::string name(event_data.event_name());
+	if (name.empty()) return;
+	if (event_data.caller()->set_active(name)) window.schedule_to_update_cache();
 }
 
 void SwitchToDefaultSchematic(Window& window, event_data_t& event_data) {
-	event_data.caller()->active_schematic() = event_data.caller()->default_schematic();
+	event_data.caller()->set_active(std::string());
 	window.schedule_to_update_cache();
 }
 
@@ -1,63 +1,180 @@
 #ifndef CUI_SFML_TIMER_EVENT_HPP
 #define CUI_SFML_TIMER_EVENT_HPP
 
+#include <atomic>
 #include <functional>
 #include <chrono>
+#include <memory>
+
+#include <aliases.hpp>
 
 using namespace std::literals::chrono_literals;
 
 namespace cui {
 
+/// \brief Cancellable handle to a scheduled timer callback
+/// \details Copies refer to the same timer. The callback is stored once in the shared state, so a
+/// repeating timer only copies the handle when it fires. Cancelling through the handle alone is lazy:
+/// the callback is skipped once due. \sa Window::timer_cancel() also removes it from the timer wheel
+class TimerHandle
+{
+public:
+	using event_t = std::function<void()>;
+	using timer_id_t = u64;
+
+	TimerHandle() = default;
+
+	[[nodiscard]] static auto create(event_t&& event) -> TimerHandle {
+		TimerHandle handle;
+		handle.state_ = std::make_shared<State>();
+		handle.state_->func = std::move(event);
+		return handle;
+	}
+
+	void operator()() const {
+		if (!cancelled()) state_->func();
+	}
+
+	/// \brief Marks the timer as cancelled
+	/// \returns A boolean indicating whether this call cancelled it
+	bool cancel() const noexcept {
+		return state_ && !state_->cancelled.exchange(true, std::memory_order_acq_rel);
+	}
+
+	[[nodiscard]] bool cancelled() const noexcept {
+		return !state_ || state_->cancelled.load(std::memory_order_acquire);
+	}
+
+	[[nodiscard]] bool valid() const noexcept {
+		return state_ != nullptr;
+	}
+
+	/// \brief The id of the timer inside its owner, only accessed under the owner's lock
+	[[nodiscard]] auto id() const noexcept -> timer_id_t& {
+		return state_->id;
+	}
+
+private:
+	struct State
+	{
+		std::atomic<bool> cancelled{false};
+		timer_id_t id = 0;
+		event_t func;
+	};
+
+	std::shared_ptr<State> state_;
+};
+
+/// \brief A callback that is due at an absolute \sa std::chrono::steady_clock deadline
+/// \details Timers created from a \sa cui::TimerHandle may repeat with a fixed interval. The time the timer
+/// was taken off the timer wheel is kept next to the deadline so its latencies can be measured when it runs.
+/// Those run the callback stored in their handle and leave \sa TimerEvent::event() empty, so copying the timer
+/// for every repetition only copies the handle
 class TimerEvent
 {
 public:
 	using steady_clock_t = std::chrono::steady_clock;
 	using standard_duration_t = steady_clock_t::duration;
+	using time_point_t = steady_clock_t::time_point;
 	template <typename Period>
 	using duration_t = std::chrono::duration<steady_clock_t::duration::rep, Period>;
 	using event_t = std::function<void()>;
 
-	template <typename Period>
-	TimerEvent(const event_t& event, const duration_t<Period> wait_duration)
-		: func_(event), duration_(std::chrono::duration_cast<standard_duration_t>(wait_duration)) {}
+	TimerEvent() = default;
+
+	TimerEvent(const event_t& event, const time_point_t p_deadline) : func_(event), deadline_(p_deadline) {}
+
+	TimerEvent(event_t&& event, const time_point_t p_deadline) : func_(std::move(event)), deadline_(p_deadline) {}
+
+	TimerEvent(const TimerHandle& p_handle, const time_point_t p_deadline, const standard_duration_t p_interval = standard_duration_t::zero())
+		: deadline_(p_deadline), interval_(p_interval), handle_(p_handle) {}
 
 	void operator()() const {
-		func_();
+		if (handle_.valid()) {
+			handle_();
+		} else {
+			func_();
+		}
+	}
+
+	[[nodiscard]] auto deadline() const noexcept -> time_point_t {
+		return deadline_;
+	}
+
+	[[nodiscard]] auto dispatched_at() const noexcept -> time_point_t {
+		return dispatched_at_;
+	}
+
+	void mark_dispatched(const time_point_t time) noexcept {
+		dispatched_at_ = time;
+	}
+
+	[[nodiscard]] auto interval() const noexcept -> standard_duration_t {
+		return interval_;
+	}
+
+	[[nodiscard]] bool repeating() const noexcept {
+		return interval_ > standard_duration_t::zero();
+	}
+
+	[[nodiscard]] auto handle() const noexcept -> const TimerHandle& {
+		return handle_;
+	}
+
+	[[nodiscard]] bool cancelled() const noexcept {
+		return handle_.valid() && handle_.cancelled();
+	}
+
+	/// \brief Moves the deadline of a repeating timer to the next interval boundary after a point in time
+	/// \details The new deadline stays on the grid of the first deadline, so the timer does not drift.
+	/// Intervals that were missed entirely are skipped instead of fired in a burst
+	/// \param now The point in time the next deadline has to be after
+	void advance_deadline(const time_point_t now) noexcept {
+		if (!repeating()) return;
+		deadline_ += interval_;
+		if (deadline_ <= now) deadline_ += interval_ * ((now - deadline_) / interval_ + 1);
+	}
+
+	[[nodiscard]] auto event() noexcept -> event_t& {
+		return func_;
 	}
 
-	[[nodiscard]] auto duration() const noexcept -> standard_duration_t {
-		return duration_;
+	[[nodiscard]] auto event() const noexcept -> const event_t& {
+		return func_;
 	}
 
 	[[nodiscard]] bool operator>(const TimerEvent& rhs) const noexcept {
-		return duration_ > rhs.duration_;
+		return deadline_ > rhs.deadline_;
 	}
 
 	[[nodiscard]] bool operator<(const TimerEvent& rhs) const noexcept {
-		return duration_ < rhs.duration_;
+		return deadline_ < rhs.deadline_;
 	}
 
 	[[nodiscard]] bool operator>=(const TimerEvent& rhs) const noexcept {
-		return duration_ >= rhs.duration_;
+		return deadline_ >= rhs.deadline_;
 	}
 
 	[[nodiscard]] bool operator<=(const TimerEvent& rhs) const noexcept {
-		return duration_ <= rhs.duration_;
+		return deadline_ <= rhs.deadline_;
 	}
 
 	[[nodiscard]] bool operator==(const TimerEvent& rhs) const noexcept {
-		return duration_ == rhs.duration_;
+		return deadline_ == rhs.deadline_;
 	}
 
 	[[nodiscard]] bool operator!=(const TimerEvent& rhs) const noexcept {
-		return duration_ != rhs.duration_;
+		return deadline_ != rhs.deadline_;
 	}
 
 private:
 	event_t func_;
-	standard_duration_t duration_;
+	time_point_t deadline_;
+	time_point_t dispatched_at_;
+	standard_duration_t interval_ = standard_duration_t::zero();
+	TimerHandle handle_;
 };
 
 }	 // namespace cui
 
-#endif	  // CUI_SFML_TIMER_EVENT_HPP
\ No newline at end of file
+#endif	  // CUI_SFML_TIMER_EVENT_HPP
@@ -0,0 +1,382 @@
+#ifndef CUI_SFML_TIMER_WHEEL_HPP
+#define CUI_SFML_TIMER_WHEEL_HPP
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <aliases.hpp>
+#include <detail/timer_event.hpp>
+
+namespace cui {
+
+/// \brief Hierarchical timing wheel holding \sa cui::TimerEvent by absolute deadline
+/// \details Deadlines are quantized to ticks of a fixed resolution, rounded up so a timer never fires early.
+/// Each of the four levels has 256 slots, every level covering 256 times the range of the one below it.
+/// Timers live in a pooled array and are linked into their slot with intrusive lists, which makes
+/// scheduling and cancelling O(1). Every level keeps a bitmap of its occupied slots, so advancing the wheel
+/// jumps straight to the next tick that expires a level 0 slot or cascades the timers of a higher level
+/// slot down, instead of visiting every tick in between
+class TimerWheel
+{
+public:
+	using steady_clock_t = std::chrono::steady_clock;
+	using standard_duration_t = steady_clock_t::duration;
+	using time_point_t = steady_clock_t::time_point;
+	using timer_t = TimerEvent;
+	using timer_id_t = u64;
+	using size_type = std::size_t;
+
+	static constexpr u32 level_count = 4;
+	static constexpr u32 slot_bits = 8;
+	static constexpr u32 slot_count = 1u << slot_bits;
+	static constexpr u32 slot_mask = slot_count - 1;
+	static constexpr timer_id_t invalid_id = 0;
+
+	explicit TimerWheel(time_point_t p_start = steady_clock_t::now(), standard_duration_t p_resolution = std::chrono::milliseconds(1));
+
+	auto schedule(timer_t&& timer) -> timer_id_t;
+
+	bool cancel(timer_id_t id) noexcept;
+
+	template <typename Sink>
+	auto advance(time_point_t now, Sink&& sink) -> size_type;
+
+	[[nodiscard]] auto next_deadline() const noexcept -> std::optional<time_point_t>;
+
+	[[nodiscard]] bool contains(timer_id_t id) const noexcept;
+
+	[[nodiscard]] auto size() const noexcept -> size_type {
+		return size_;
+	}
+
+	[[nodiscard]] bool empty() const noexcept {
+		return size_ == 0;
+	}
+
+	[[nodiscard]] auto resolution() const noexcept -> standard_duration_t {
+		return resolution_;
+	}
+
+	[[nodiscard]] auto current_time() const noexcept -> time_point_t {
+		return tick_to_time(current_tick_);
+	}
+
+private:
+	static constexpr u32 npos = std::numeric_limits<u32>::max();
+	static constexpr u32 due_list = level_count * slot_count;
+	static constexpr u32 word_count = slot_count / 64;
+
+	struct Entry
+	{
+		timer_t timer;
+		u64 tick = 0;
+		u32 prev = npos;
+		u32 next = npos;
+		u32 list = npos;
+		u32 generation = 1;
+	};
+
+	struct List
+	{
+		u32 head = npos;
+		u32 tail = npos;
+	};
+
+	[[nodiscard]] auto time_to_tick(time_point_t time) const noexcept -> u64;
+	[[nodiscard]] auto tick_to_time(u64 tick) const noexcept -> time_point_t;
+	[[nodiscard]] auto list_for(u64 tick) const noexcept -> u32;
+	[[nodiscard]] auto next_occupied(u32 level, u32 from) const noexcept -> u32;
+	[[nodiscard]] auto next_event_tick() const noexcept -> u64;
+	[[nodiscard]] static auto lowest_bit(u64 word) noexcept -> u32;
+
+	void mark(u32 list, bool occupied) noexcept;
+
+	void link(u32 list, u32 index) noexcept;
+	void unlink(u32 index) noexcept;
+	auto detach(u32 list) noexcept -> u32;
+	void release(u32 index) noexcept;
+	void cascade(u32 level);
+
+	template <typename Sink>
+	auto expire(u32 list, Sink& sink) -> size_type;
+
+	time_point_t start_;
+	standard_duration_t resolution_;
+	u64 current_tick_;
+	u64 horizon_;
+	size_type size_;
+	std::vector<Entry> entries_;
+	std::vector<u32> free_;
+	std::array<List, level_count * slot_count + 1> lists_;
+	std::array<std::array<u64, word_count>, level_count> occupied_;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Constructs an empty wheel
+/// \param p_start The time of tick zero
+/// \param p_resolution The duration of a single tick
+TimerWheel::TimerWheel(const time_point_t p_start, const standard_duration_t p_resolution)
+	: start_(p_start), resolution_(std::max(p_resolution, standard_duration_t(1))), current_tick_(0), horizon_(0), size_(0), lists_{}, occupied_{} {}
+
+/// \brief Schedules a timer
+/// \details A timer whose deadline has already passed expires on the next \sa TimerWheel::advance()
+/// \param timer The timer to schedule
+/// \returns The id used to cancel the timer, never \sa TimerWheel::invalid_id
+auto TimerWheel::schedule(timer_t&& timer) -> timer_id_t {
+	u32 index;
+	if (free_.empty()) {
+		index = static_cast<u32>(entries_.size());
+		entries_.emplace_back();
+	} else {
+		index = free_.back();
+		free_.pop_back();
+	}
+
+	auto& entry = entries_[index];
+	entry.tick = time_to_tick(timer.deadline());
+	entry.timer = std::move(timer);
+	link(list_for(entry.tick), index);
+	++size_;
+
+	return (static_cast<timer_id_t>(entry.generation) << 32) | index;
+}
+
+/// \brief Cancels a pending timer
+/// \param id The id returned by \sa TimerWheel::schedule()
+/// \returns A boolean indicating whether the timer was still pending
+bool TimerWheel::cancel(const timer_id_t id) noexcept {
+	if (!contains(id)) return false;
+
+	const auto index = static_cast<u32>(id & 0xFFFFFFFF);
+	unlink(index);
+	release(index);
+	return true;
+}
+
+/// \brief Checks whether a timer is still pending
+/// \param id The id returned by \sa TimerWheel::schedule()
+/// \returns A boolean indicating whether the timer is pending
+bool TimerWheel::contains(const timer_id_t id) const noexcept {
+	const auto index = static_cast<u32>(id & 0xFFFFFFFF);
+	const auto generation = static_cast<u32>(id >> 32);
+	if (index >= entries_.size()) return false;
+
+	const auto& entry = entries_[index];
+	return entry.generation == generation && entry.list != npos;
+}
+
+/// \brief Advances the wheel and expires every timer whose deadline is not after the given time
+/// \details Expired timers are handed to the sink in deadline order, quantized to the tick resolution.
+/// The sink may schedule new timers; those that are already due expire on the next tick the wheel visits.
+/// Only ticks with work are visited, so the cost depends on the occupied slots and not on the time skipped
+/// \param now The time to advance to
+/// \param sink A callable receiving each expired \sa cui::TimerEvent as an rvalue
+/// \returns The amount of expired timers
+template <typename Sink>
+auto TimerWheel::advance(const time_point_t now, Sink&& sink) -> size_type {
+	const auto target = now < start_ ? 0 : static_cast<u64>((now - start_) / resolution_);
+	size_type expired = expire(due_list, sink);
+
+	while (current_tick_ < target) {
+		if (horizon_ <= current_tick_) horizon_ = next_event_tick();
+		const auto next = lists_[due_list].head != npos ? current_tick_ + 1 : horizon_;
+		if (next > target) {
+			current_tick_ = target;
+			break;
+		}
+
+		current_tick_ = next;
+		for (u32 level = 1; level < level_count; ++level) {
+			if (((current_tick_ >> (slot_bits * (level - 1))) & slot_mask) != 0) break;
+			cascade(level);
+		}
+
+		expired += expire(due_list, sink);
+		expired += expire(static_cast<u32>(current_tick_ & slot_mask), sink);
+	}
+
+	return expired;
+}
+
+/// \brief Gets the earliest time at which the wheel has work to do
+/// \details Exact for level 0 timers. Higher levels report the time their slot cascades, which is never
+/// later than the deadlines stored in it, so waiting until this time and advancing never misses a timer
+/// \returns The time to advance at or nothing if the wheel is empty
+auto TimerWheel::next_deadline() const noexcept -> std::optional<time_point_t> {
+	if (size_ == 0) return std::nullopt;
+	if (lists_[due_list].head != npos) return tick_to_time(current_tick_);
+	return tick_to_time(next_event_tick());
+}
+
+/// \brief Converts a time to a tick, rounding up
+auto TimerWheel::time_to_tick(const time_point_t time) const noexcept -> u64 {
+	if (time <= start_) return 0;
+	const auto elapsed = time - start_;
+	return static_cast<u64>((elapsed + resolution_ - standard_duration_t(1)) / resolution_);
+}
+
+/// \brief Converts a tick to the time it starts at
+auto TimerWheel::tick_to_time(const u64 tick) const noexcept -> time_point_t {
+	return start_ + resolution_ * static_cast<standard_duration_t::rep>(tick);
+}
+
+/// \brief Picks the list a timer with the given tick belongs to
+/// \details Ticks beyond the range of the top level are parked in the furthest top level slot and
+/// get placed again whenever that slot cascades
+auto TimerWheel::list_for(const u64 tick) const noexcept -> u32 {
+	if (tick <= current_tick_) return due_list;
+
+	const auto delta = tick - current_tick_;
+	for (u32 level = 0; level < level_count; ++level) {
+		const auto shift = slot_bits * level;
+		if ((delta >> shift) < slot_count) return level * slot_count + static_cast<u32>((tick >> shift) & slot_mask);
+	}
+
+	const auto shift = slot_bits * (level_count - 1);
+	return (level_count - 1) * slot_count + static_cast<u32>(((current_tick_ >> shift) + slot_mask) & slot_mask);
+}
+
+/// \brief Finds the first occupied slot of a level, searching forward from a slot and wrapping around
+/// \returns The distance from the given slot or \sa TimerWheel::slot_count if the level is empty
+auto TimerWheel::next_occupied(const u32 level, const u32 from) const noexcept -> u32 {
+	const auto& bits = occupied_[level];
+	for (u32 i = 0; i <= word_count; ++i) {
+		const auto word = ((from >> 6) + i) % word_count;
+		auto mask = bits[word];
+		if (i == 0) mask &= ~u64(0) << (from & 63);
+		if (i == word_count) mask &= (u64(1) << (from & 63)) - 1;
+		if (mask != 0) return (word * 64 + lowest_bit(mask) - from) & slot_mask;
+	}
+	return slot_count;
+}
+
+/// \brief Gets the next tick after the current one that expires a level 0 slot or cascades a higher level slot
+/// \returns The tick or the largest tick if no slot is occupied
+auto TimerWheel::next_event_tick() const noexcept -> u64 {
+	auto best = std::numeric_limits<u64>::max();
+	for (u32 level = 0; level < level_count; ++level) {
+		const auto shift = slot_bits * level;
+		const auto block = (current_tick_ >> shift) + 1;
+		const auto distance = next_occupied(level, static_cast<u32>(block & slot_mask));
+		if (distance == slot_count) continue;
+		best = std::min(best, (block + distance) << shift);
+	}
+	return best;
+}
+
+/// \brief Gets the index of the lowest set bit of a non zero word
+auto TimerWheel::lowest_bit(u64 word) noexcept -> u32 {
+#if defined(__GNUC__) || defined(__clang__)
+	return static_cast<u32>(__builtin_ctzll(word));
+#else
+	u32 index = 0;
+	for (; (word & 1) == 0; word >>= 1) ++index;
+	return index;
+#endif
+}
+
+/// \brief Updates the occupancy bit of a slot list, the due list has none
+/// \details A newly occupied slot may come before the cached next event tick, which is then recomputed on
+/// the next advance. Emptied slots leave it in place, visiting a tick without work is harmless
+void TimerWheel::mark(const u32 list, const bool occupied) noexcept {
+	if (list == due_list) return;
+	if (occupied) horizon_ = 0;
+	auto& word = occupied_[list / slot_count][(list & slot_mask) >> 6];
+	const auto bit = u64(1) << (list & 63);
+	word = occupied ? word | bit : word & ~bit;
+}
+
+/// \brief Appends an entry to the tail of a list
+void TimerWheel::link(const u32 list, const u32 index) noexcept {
+	auto& entry = entries_[index];
+	auto& l = lists_[list];
+	entry.list = list;
+	entry.next = npos;
+	entry.prev = l.tail;
+	if (l.tail != npos) {
+		entries_[l.tail].next = index;
+	} else {
+		l.head = index;
+		mark(list, true);
+	}
+	l.tail = index;
+}
+
+/// \brief Removes an entry from the list it is linked into
+void TimerWheel::unlink(const u32 index) noexcept {
+	auto& entry = entries_[index];
+	auto& l = lists_[entry.list];
+	if (entry.prev != npos) {
+		entries_[entry.prev].next = entry.next;
+	} else {
+		l.head = entry.next;
+	}
+	if (entry.next != npos) {
+		entries_[entry.next].prev = entry.prev;
+	} else {
+		l.tail = entry.prev;
+	}
+	if (l.head == npos) mark(entry.list, false);
+	entry.prev = entry.next = entry.list = npos;
+}
+
+/// \brief Empties a list
+/// \returns The head of the detached chain
+auto TimerWheel::detach(const u32 list) noexcept -> u32 {
+	auto& l = lists_[list];
+	const auto head = l.head;
+	l.head = l.tail = npos;
+	mark(list, false);
+	return head;
+}
+
+/// \brief Returns an unlinked entry to the pool and invalidates its id
+void TimerWheel::release(const u32 index) noexcept {
+	auto& entry = entries_[index];
+	entry.timer = timer_t{};
+	entry.list = npos;
+	++entry.generation;
+	if (entry.generation == 0) entry.generation = 1;
+	free_.push_back(index);
+	--size_;
+}
+
+/// \brief Moves the timers of the current slot of a level into the levels below
+void TimerWheel::cascade(const u32 level) {
+	const auto slot = static_cast<u32>((current_tick_ >> (slot_bits * level)) & slot_mask);
+	auto index = detach(level * slot_count + slot);
+	while (index != npos) {
+		const auto next = entries_[index].next;
+		link(list_for(entries_[index].tick), index);
+		index = next;
+	}
+}
+
+/// \brief Expires every timer of a list
+/// \details Pops one timer at a time so the sink may cancel or schedule timers. Timers linked into
+/// the list by the sink are left for the next call
+template <typename Sink>
+auto TimerWheel::expire(const u32 list, Sink& sink) -> size_type {
+	size_type pending = 0;
+	for (auto index = lists_[list].head; index != npos; index = entries_[index].next) ++pending;
+
+	size_type expired = 0;
+	for (; expired < pending && lists_[list].head != npos; ++expired) {
+		const auto index = lists_[list].head;
+		unlink(index);
+		auto timer = std::move(entries_[index].timer);
+		release(index);
+		sink(std::move(timer));
+	}
+	return expired;
+}
+
+}	 // namespace cui
+
+#endif	  // CUI_SFML_TIMER_WHEEL_HPP
@@ -0,0 +1,66 @@
+#ifndef CUI_SFML_TRIPLE_BUFFER_HPP
+#define CUI_SFML_TRIPLE_BUFFER_HPP
+
+#include <array>
+#include <atomic>
+
+#include <aliases.hpp>
+
+namespace cui {
+
+/// \brief Lock-free single producer, single consumer triple buffer
+/// \details The producer fills the back slot and publishes it, the consumer picks up the latest published
+/// slot. Neither side ever waits for the other, intermediate slots the consumer did not pick up in time are
+/// overwritten. Slots are reused, so a producer that assigns into the back slot reuses its allocations. A
+/// consumer that wants to block until a slot is published pairs \sa TripleBuffer::fresh() with its own
+/// condition variable
+template <typename T>
+class TripleBuffer
+{
+public:
+	/// \brief Gets the slot the producer writes to
+	[[nodiscard]] auto back() noexcept -> T& {
+		return slots_[back_];
+	}
+
+	/// \brief Hands the back slot to the consumer and takes over the previous middle slot
+	void publish() noexcept {
+		back_ = state_.exchange(static_cast<u8>(back_ | fresh_bit), std::memory_order_acq_rel) & index_mask;
+	}
+
+	/// \brief Takes over the latest published slot if there is a new one
+	/// \returns A boolean indicating whether the front slot changed
+	bool consume() noexcept {
+		if (!(state_.load(std::memory_order_acquire) & fresh_bit)) return false;
+		front_ = state_.exchange(front_, std::memory_order_acq_rel) & index_mask;
+		return true;
+	}
+
+	/// \brief Checks whether a published slot waits to be consumed
+	[[nodiscard]] bool fresh() const noexcept {
+		return state_.load(std::memory_order_acquire) & fresh_bit;
+	}
+
+	/// \brief Gets the slot the consumer reads from
+	[[nodiscard]] auto front() noexcept -> T& {
+		return slots_[front_];
+	}
+
+	/// \brief Gets the slot the consumer reads from
+	[[nodiscard]] auto front() const noexcept -> const T& {
+		return slots_[front_];
+	}
+
+private:
+	static constexpr u8 fresh_bit = 4;
+	static constexpr u8 index_mask = 3;
+
+	std::array<T, 3> slots_{};
+	u8 back_ = 0;
+	u8 front_ = 1;
+	std::atomic<u8> state_{2};
+};
+
+}	 // namespace cui
+
+#endif	  // CUI_SFML_TRIPLE_BUFFER_HPP
@@ -0,0 +1,446 @@
+#ifndef CUI_SFML_WORKER_POOL_HPP
+#define CUI_SFML_WORKER_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <aliases.hpp>
+#include <detail/latency_histogram.hpp>
+
+namespace cui {
+
+/// \brief Shared cancellation and completion state of a task running on the \sa cui::WorkerPool
+/// \details Copies of a handle refer to the same task. Cancellation is cooperative: a task that
+/// has not started yet is skipped, a running task is expected to poll \sa TaskHandle::cancelled()
+class TaskHandle
+{
+	struct State
+	{
+		std::atomic<bool> cancelled{false};
+		std::atomic<bool> done{false};
+	};
+
+public:
+	TaskHandle() : state_(std::make_shared<State>()) {}
+
+	void cancel() const noexcept {
+		state_->cancelled.store(true, std::memory_order_release);
+	}
+
+	[[nodiscard]] bool cancelled() const noexcept {
+		return state_->cancelled.load(std::memory_order_acquire);
+	}
+
+	[[nodiscard]] bool done() const noexcept {
+		return state_->done.load(std::memory_order_acquire);
+	}
+
+	void mark_done() const noexcept {
+		state_->done.store(true, std::memory_order_release);
+	}
+
+private:
+	std::shared_ptr<State> state_;
+};
+
+/// \brief A fixed amount of worker threads executing submitted tasks with work stealing
+/// \details Every worker owns a deque. Tasks submitted from a worker go to its own deque and are popped
+/// LIFO while they are still hot in the cache, tasks submitted from other threads are spread round-robin.
+/// An idle worker steals the oldest task of another worker before it goes to sleep. Tasks pinned to a
+/// worker are never stolen. The pool never runs tasks on the submitting thread, so the UI thread stays free
+class WorkerPool
+{
+public:
+	using size_type = std::size_t;
+	using task_t = std::function<void()>;
+	using steady_clock_t = std::chrono::steady_clock;
+	using time_point_t = steady_clock_t::time_point;
+
+	static constexpr size_type any_worker = std::numeric_limits<size_type>::max();
+
+	/// \brief Per-task timing of a worker, or of the whole pool when merged
+	struct Stats
+	{
+		u64 executed = 0;
+		u64 stolen = 0;
+		LatencyHistogram queue_time;
+		LatencyHistogram run_time;
+	};
+
+	explicit WorkerPool(size_type worker_count = default_worker_count());
+
+	WorkerPool(const WorkerPool&) = delete;
+	auto operator=(const WorkerPool&) -> WorkerPool& = delete;
+
+	~WorkerPool();
+
+	bool submit(task_t&& task, size_type affinity = any_worker);
+
+	bool run_one();
+
+	void stop();
+
+	[[nodiscard]] auto stats() const -> Stats;
+
+	[[nodiscard]] auto worker_stats(size_type worker) const -> Stats;
+
+	void reset_stats();
+
+	[[nodiscard]] auto worker_count() const noexcept -> size_type {
+		return workers_.size();
+	}
+
+	/// \brief Gets the index of the worker running the calling thread
+	/// \returns The worker index, or \sa WorkerPool::any_worker if the caller is not a worker of this pool
+	[[nodiscard]] auto current_worker() const noexcept -> size_type {
+		return current_pool_ == this ? current_index_ : any_worker;
+	}
+
+	[[nodiscard]] static auto default_worker_count() noexcept -> size_type {
+		const size_type hw = std::thread::hardware_concurrency();
+		return std::max<size_type>(1, hw > 2 ? hw - 2 : 1);
+	}
+
+private:
+	struct Job
+	{
+		task_t task;
+		time_point_t enqueued_at;
+	};
+
+	struct Worker
+	{
+		std::mutex mutex;
+		std::deque<Job> jobs;
+		std::deque<Job> pinned;
+		std::atomic<size_type> pinned_count{0};
+
+		mutable std::mutex stats_mutex;
+		Stats stats;
+	};
+
+	void work(size_type index);
+	bool try_pop(size_type index, Job& job, bool& stolen);
+	void execute(size_type index, Job& job, bool stolen);
+	[[nodiscard]] bool has_work(size_type index) const noexcept;
+
+	inline static thread_local const WorkerPool* current_pool_ = nullptr;
+	inline static thread_local size_type current_index_ = any_worker;
+
+	std::vector<std::unique_ptr<Worker>> workers_;
+	std::vector<std::thread> threads_;
+	std::atomic<size_type> pending_{0};
+	std::atomic<size_type> next_worker_{0};
+	std::atomic<bool> stopping_{false};
+	std::mutex sleep_mutex_;
+	std::condition_variable cv_;
+};
+
+/// \brief A set of tasks on a \sa cui::WorkerPool that can be waited for as a whole
+/// \details The first exception thrown by a task of the group is rethrown by \sa TaskGroup::wait(). Waiting on a
+/// worker thread runs other tasks of the pool meanwhile, so nested groups cannot starve the pool. Waiting on
+/// any other thread blocks. The destructor waits for the remaining tasks and swallows their exceptions
+class TaskGroup
+{
+public:
+	using size_type = WorkerPool::size_type;
+	using task_t = WorkerPool::task_t;
+
+	explicit TaskGroup(WorkerPool& p_pool) : pool_(p_pool), state_(std::make_shared<State>()) {}
+
+	TaskGroup(const TaskGroup&) = delete;
+	auto operator=(const TaskGroup&) -> TaskGroup& = delete;
+
+	~TaskGroup();
+
+	void run(task_t&& task, size_type affinity = WorkerPool::any_worker);
+
+	void wait();
+
+	[[nodiscard]] bool done() const noexcept {
+		return state_->pending.load(std::memory_order_acquire) == 0;
+	}
+
+private:
+	struct State
+	{
+		std::atomic<size_type> pending{0};
+		std::mutex mutex;
+		std::condition_variable cv;
+		std::exception_ptr exception;
+	};
+
+	WorkerPool& pool_;
+	std::shared_ptr<State> state_;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Spawns the worker threads
+/// \param worker_count The amount of worker threads, at least one is spawned
+WorkerPool::WorkerPool(const size_type worker_count) {
+	const auto count = std::max<size_type>(1, worker_count);
+	workers_.reserve(count);
+	for (size_type i = 0; i < count; ++i) workers_.push_back(std::make_unique<Worker>());
+
+	threads_.reserve(count);
+	for (size_type i = 0; i < count; ++i) {
+		threads_.emplace_back([this, i] { this->work(i); });
+	}
+}
+
+/// \brief Stops the pool and joins the worker threads
+WorkerPool::~WorkerPool() {
+	stop();
+}
+
+/// \brief Enqueues a task
+/// \details Tasks submitted after \sa WorkerPool::stop() are discarded. The pending count is reserved before the
+/// stop flag is checked, so a task is either rejected or drained by the workers before they exit
+/// \param task The task to execute
+/// \param affinity The worker the task is pinned to, \sa WorkerPool::any_worker lets any worker run it
+/// \returns A boolean indicating whether the task was accepted
+bool WorkerPool::submit(task_t&& task, const size_type affinity) {
+	const auto pinned = affinity != any_worker;
+	const auto current = current_worker();
+	const auto index = pinned ? affinity % workers_.size()
+					   : current != any_worker ? current
+											   : next_worker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+	auto& worker = *workers_[index];
+	auto& counter = pinned ? worker.pinned_count : pending_;
+
+	counter.fetch_add(1);
+	if (stopping_.load()) {
+		counter.fetch_sub(1);
+		return false;
+	}
+
+	{
+		std::unique_lock lock(worker.mutex);
+		(pinned ? worker.pinned : worker.jobs).push_back(Job{std::move(task), steady_clock_t::now()});
+	}
+	{
+		std::unique_lock lock(sleep_mutex_);
+	}
+	if (pinned) {
+		cv_.notify_all();
+	} else {
+		cv_.notify_one();
+	}
+	return true;
+}
+
+/// \brief Runs a single pending task on the calling worker thread
+/// \details Used to help while waiting, does nothing when called from a thread outside the pool
+/// \returns A boolean indicating whether a task ran
+bool WorkerPool::run_one() {
+	const auto index = current_worker();
+	if (index == any_worker) return false;
+
+	Job job;
+	bool stolen = false;
+	if (!try_pop(index, job, stolen)) return false;
+	execute(index, job, stolen);
+	return true;
+}
+
+/// \brief Stops accepting tasks, lets the workers finish the queued ones and joins them
+void WorkerPool::stop() {
+	{
+		std::unique_lock lock(sleep_mutex_);
+		if (stopping_.exchange(true)) return;
+	}
+	cv_.notify_all();
+	for (auto& thread : threads_) {
+		if (thread.joinable()) thread.join();
+	}
+}
+
+/// \brief Merges the stats of every worker
+auto WorkerPool::stats() const -> Stats {
+	Stats merged;
+	for (size_type i = 0; i < workers_.size(); ++i) {
+		const auto& worker = *workers_[i];
+		std::unique_lock lock(worker.stats_mutex);
+		merged.executed += worker.stats.executed;
+		merged.stolen += worker.stats.stolen;
+		merged.queue_time.merge(worker.stats.queue_time);
+		merged.run_time.merge(worker.stats.run_time);
+	}
+	return merged;
+}
+
+/// \brief Gets the stats of a single worker
+/// \param worker The index of the worker
+auto WorkerPool::worker_stats(const size_type worker) const -> Stats {
+	const auto& w = *workers_.at(worker);
+	std::unique_lock lock(w.stats_mutex);
+	return w.stats;
+}
+
+/// \brief Clears the stats of every worker
+void WorkerPool::reset_stats() {
+	for (auto& worker : workers_) {
+		std::unique_lock lock(worker->stats_mutex);
+		worker->stats.executed = 0;
+		worker->stats.stolen = 0;
+		worker->stats.queue_time.reset();
+		worker->stats.run_time.reset();
+	}
+}
+
+/// \brief Worker thread loop
+/// \details Runs tasks while there are any, then sleeps until a task is submitted or the pool is stopped.
+/// Exits once stopped and drained
+/// \param index The index of the worker
+void WorkerPool::work(const size_type index) {
+	current_pool_ = this;
+	current_index_ = index;
+
+	while (true) {
+		Job job;
+		bool stolen = false;
+		if (try_pop(index, job, stolen)) {
+			execute(index, job, stolen);
+			continue;
+		}
+
+		std::unique_lock lock(sleep_mutex_);
+		cv_.wait(lock, [this, index] { return stopping_.load() || has_work(index); });
+		if (!has_work(index)) return;
+	}
+}
+
+/// \brief Takes the next task for a worker
+/// \details Pinned tasks come first, then the newest task of the own deque, then the oldest task of another worker
+/// \param index The index of the worker
+/// \param job Receives the task
+/// \param stolen Set if the task was taken from another worker
+/// \returns A boolean indicating whether a task was found
+bool WorkerPool::try_pop(const size_type index, Job& job, bool& stolen) {
+	auto& own = *workers_[index];
+	{
+		std::unique_lock lock(own.mutex);
+		if (!own.pinned.empty()) {
+			job = std::move(own.pinned.front());
+			own.pinned.pop_front();
+			own.pinned_count.fetch_sub(1);
+			return true;
+		}
+		if (!own.jobs.empty()) {
+			job = std::move(own.jobs.back());
+			own.jobs.pop_back();
+			pending_.fetch_sub(1);
+			return true;
+		}
+	}
+
+	for (size_type offset = 1; offset < workers_.size(); ++offset) {
+		auto& victim = *workers_[(index + offset) % workers_.size()];
+		std::unique_lock lock(victim.mutex, std::try_to_lock);
+		if (!lock.owns_lock() || victim.jobs.empty()) continue;
+
+		job = std::move(victim.jobs.front());
+		victim.jobs.pop_front();
+		pending_.fetch_sub(1);
+		stolen = true;
+		return true;
+	}
+	return false;
+}
+
+/// \brief Runs a task and records its timing
+void WorkerPool::execute(const size_type index, Job& job, const bool stolen) {
+	const auto start = steady_clock_t::now();
+	job.task();
+	const auto end = steady_clock_t::now();
+
+	auto& worker = *workers_[index];
+	std::unique_lock lock(worker.stats_mutex);
+	++worker.stats.executed;
+	if (stolen) ++worker.stats.stolen;
+	worker.stats.queue_time.record(std::chrono::duration_cast<LatencyHistogram::duration_t>(start - job.enqueued_at));
+	worker.stats.run_time.record(std::chrono::duration_cast<LatencyHistogram::duration_t>(end - start));
+}
+
+/// \brief Checks whether a worker could find a task
+/// \details A stealable task may be claimed by another worker in the meantime, the worker then polls once more
+bool WorkerPool::has_work(const size_type index) const noexcept {
+	return pending_.load() > 0 || workers_[index]->pinned_count.load() > 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Waits for the remaining tasks
+TaskGroup::~TaskGroup() {
+	try {
+		wait();
+	} catch (...) {}
+}
+
+/// \brief Submits a task as part of the group
+/// \details A task rejected by a stopping pool never runs. The rejection is thrown right away and also kept
+/// as the exception of the group, so a \sa TaskGroup::wait() elsewhere does not mistake the group for complete
+/// \param task The task to execute
+/// \param affinity The worker the task is pinned to, see \sa WorkerPool::submit()
+void TaskGroup::run(task_t&& task, const size_type affinity) {
+	state_->pending.fetch_add(1, std::memory_order_acq_rel);
+	const auto accepted = pool_.submit(
+	  [state = state_, fn = std::move(task)] {
+		  try {
+			  fn();
+		  } catch (...) {
+			  std::unique_lock lock(state->mutex);
+			  if (!state->exception) state->exception = std::current_exception();
+		  }
+
+		  if (state->pending.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+		  std::unique_lock lock(state->mutex);
+		  state->cv.notify_all();
+	  },
+	  affinity);
+	if (accepted) return;
+
+	const auto rejection = std::make_exception_ptr(std::runtime_error("The worker pool is stopping"));
+	{
+		std::unique_lock lock(state_->mutex);
+		if (!state_->exception) state_->exception = rejection;
+		if (state_->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) state_->cv.notify_all();
+	}
+	std::rethrow_exception(rejection);
+}
+
+/// \brief Waits until every task of the group finished
+/// \details Rethrows the first exception thrown by a task, the exception is cleared afterwards
+void TaskGroup::wait() {
+	if (pool_.current_worker() != WorkerPool::any_worker) {
+		while (!done()) {
+			if (!pool_.run_one()) std::this_thread::yield();
+		}
+	} else {
+		std::unique_lock lock(state_->mutex);
+		state_->cv.wait(lock, [this] { return done(); });
+	}
+
+	std::unique_lock lock(state_->mutex);
+	if (!state_->exception) return;
+	auto exception = std::exchange(state_->exception, nullptr);
+	lock.unlock();
+	std::rethrow_exception(exception);
+}
+
+}	 // namespace cui
+
+#endif	  // CUI_SFML_WORKER_POOL_HPP
@@ -0,0 +1,292 @@
+#ifndef CUI_SFML_EVENT_RECORDER_HPP
+#define CUI_SFML_EVENT_RECORDER_HPP
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <aliases.hpp>
+
+#include <SFML/Window/Event.hpp>
+
+namespace cui {
+
+namespace detail {
+
+/// \brief Size of the \sa sf::Event union member that is active for an event type
+/// \param type The event type
+/// \returns The amount of payload bytes that need to be stored for the event type
+auto event_payload_size(const sf::Event::EventType type) noexcept -> std::size_t {
+	using EventType = sf::Event::EventType;
+	switch (type) {
+		case EventType::Resized: return sizeof(sf::Event::SizeEvent);
+		case EventType::TextEntered: return sizeof(sf::Event::TextEvent);
+		case EventType::KeyPressed:
+		case EventType::KeyReleased: return sizeof(sf::Event::KeyEvent);
+		case EventType::MouseWheelMoved: return sizeof(sf::Event::MouseWheelEvent);
+		case EventType::MouseWheelScrolled: return sizeof(sf::Event::MouseWheelScrollEvent);
+		case EventType::MouseButtonPressed:
+		case EventType::MouseButtonReleased: return sizeof(sf::Event::MouseButtonEvent);
+		case EventType::MouseMoved: return sizeof(sf::Event::MouseMoveEvent);
+		case EventType::JoystickButtonPressed:
+		case EventType::JoystickButtonReleased: return sizeof(sf::Event::JoystickButtonEvent);
+		case EventType::JoystickMoved: return sizeof(sf::Event::JoystickMoveEvent);
+		case EventType::JoystickConnected:
+		case EventType::JoystickDisconnected: return sizeof(sf::Event::JoystickConnectEvent);
+		case EventType::TouchBegan:
+		case EventType::TouchMoved:
+		case EventType::TouchEnded: return sizeof(sf::Event::TouchEvent);
+		case EventType::SensorChanged: return sizeof(sf::Event::SensorEvent);
+		default: return 0;
+	}
+}
+
+}	 // namespace detail
+
+/// \brief A polled-for event together with its offset from the start of the recording
+struct RecordedEvent
+{
+	std::chrono::nanoseconds timestamp;
+	sf::Event event;
+};
+
+/// \brief Serializes a stream of \sa sf::Event into a compact binary file
+/// \details The file starts with a magic and a version, followed by one record per event:
+/// the LEB128 encoded nanosecond delta to the previous event, the event type byte and the raw bytes
+/// of the active union member. Payloads are stored in native byte order
+class EventRecorder
+{
+public:
+	using steady_clock_t = std::chrono::steady_clock;
+	using time_point_t = steady_clock_t::time_point;
+
+	static constexpr char magic[4] = {'C', 'U', 'I', 'R'};
+	static constexpr u32 version = 1;
+
+	EventRecorder() = default;
+
+	explicit EventRecorder(const std::string& path);
+
+	void open(const std::string& path);
+
+	void record(const sf::Event& event);
+
+	void record(const sf::Event& event, time_point_t time);
+
+	void close();
+
+	[[nodiscard]] bool is_open() const noexcept {
+		return stream_.is_open();
+	}
+
+	[[nodiscard]] auto recorded_count() const noexcept -> u64 {
+		return count_;
+	}
+
+private:
+	void write_varint(u64 value);
+
+	std::ofstream stream_;
+	time_point_t start_;
+	std::chrono::nanoseconds previous_;
+	u64 count_ = 0;
+};
+
+/// \brief Feeds a recorded \sa sf::Event stream back into a consumer such as \sa Window::process_event
+/// \details Replays either at the recorded pace or as fast as possible. In both modes a virtual clock
+/// follows the recorded timestamps, so a consumer observes the same timeline regardless of speed
+class EventReplayer
+{
+public:
+	using steady_clock_t = std::chrono::steady_clock;
+	using consumer_t = std::function<void(const sf::Event&)>;
+	using step_t = std::function<void(std::chrono::nanoseconds)>;
+
+	enum class Speed
+	{
+		Recorded,
+		Maximum
+	};
+
+	/// \brief Timings gathered during a replay
+	struct Stats
+	{
+		u64 event_count = 0;
+		std::chrono::nanoseconds recorded_duration{0};
+		std::chrono::nanoseconds wall_duration{0};
+		std::chrono::nanoseconds processing_duration{0};
+		std::chrono::nanoseconds max_event_duration{0};
+	};
+
+	EventReplayer() = default;
+
+	explicit EventReplayer(const std::string& path);
+
+	void load(const std::string& path);
+
+	auto replay(const consumer_t& consumer, Speed speed = Speed::Maximum, const step_t& step = {}) -> Stats;
+
+	[[nodiscard]] auto events() const noexcept -> const std::vector<RecordedEvent>& {
+		return events_;
+	}
+
+	[[nodiscard]] auto virtual_time() const noexcept -> std::chrono::nanoseconds {
+		return virtual_time_;
+	}
+
+private:
+	std::vector<RecordedEvent> events_;
+	std::chrono::nanoseconds virtual_time_{0};
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Constructs the recorder and opens the output file
+/// \param path The path of the recording
+EventRecorder::EventRecorder(const std::string& path) {
+	open(path);
+}
+
+/// \brief Opens the output file and writes the header
+/// \details Truncates an existing file. Throws if the file cannot be opened
+/// \param path The path of the recording
+void EventRecorder::open(const std::string& path) {
+	close();
+	stream_.open(path, std::ios::binary | std::ios::trunc);
+	if (!stream_.is_open()) throw std::runtime_error("Could not open the event recording file");
+
+	stream_.write(magic, sizeof(magic));
+	stream_.write(reinterpret_cast<const char*>(&version), sizeof(version));
+	start_ = steady_clock_t::now();
+	previous_ = std::chrono::nanoseconds::zero();
+	count_ = 0;
+}
+
+/// \brief Records an event with the current time
+/// \param event The polled-for event
+void EventRecorder::record(const sf::Event& event) {
+	record(event, steady_clock_t::now());
+}
+
+/// \brief Records an event with an explicit time
+/// \param event The polled-for event
+/// \param time The time the event was polled at
+void EventRecorder::record(const sf::Event& event, const time_point_t time) {
+	if (!stream_.is_open()) return;
+
+	const auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(time - start_);
+	const auto delta = timestamp > previous_ ? timestamp - previous_ : std::chrono::nanoseconds::zero();
+	previous_ += delta;
+
+	write_varint(static_cast<u64>(delta.count()));
+	const auto type = static_cast<u8>(event.type);
+	stream_.put(static_cast<char>(type));
+	stream_.write(reinterpret_cast<const char*>(&event.size), detail::event_payload_size(event.type));
+	++count_;
+}
+
+/// \brief Flushes and closes the output file
+void EventRecorder::close() {
+	if (stream_.is_open()) stream_.close();
+}
+
+/// \brief Writes an unsigned LEB128 integer
+void EventRecorder::write_varint(u64 value) {
+	do {
+		u8 byte = value & 0x7F;
+		value >>= 7;
+		if (value != 0) byte |= 0x80;
+		stream_.put(static_cast<char>(byte));
+	} while (value != 0);
+}
+
+/// \brief Constructs the replayer and loads a recording
+/// \param path The path of the recording
+EventReplayer::EventReplayer(const std::string& path) {
+	load(path);
+}
+
+/// \brief Loads a recording into memory
+/// \details Throws if the file cannot be opened, has a foreign header or is truncated
+/// \param path The path of the recording
+void EventReplayer::load(const std::string& path) {
+	std::ifstream stream(path, std::ios::binary);
+	if (!stream.is_open()) throw std::runtime_error("Could not open the event recording file");
+
+	char file_magic[sizeof(EventRecorder::magic)];
+	u32 file_version = 0;
+	stream.read(file_magic, sizeof(file_magic));
+	stream.read(reinterpret_cast<char*>(&file_version), sizeof(file_version));
+	if (!stream || std::memcmp(file_magic, EventRecorder::magic, sizeof(file_magic)) != 0 || file_version != EventRecorder::version) {
+		throw std::runtime_error("Not a supported event recording file");
+	}
+
+	events_.clear();
+	virtual_time_ = std::chrono::nanoseconds::zero();
+	std::chrono::nanoseconds timestamp{0};
+	while (stream.peek() != std::ifstream::traits_type::eof()) {
+		u64 delta = 0;
+		u32 shift = 0;
+		int byte = 0;
+		do {
+			byte = stream.get();
+			if (byte == std::ifstream::traits_type::eof()) throw std::runtime_error("Truncated event recording file");
+			delta |= static_cast<u64>(byte & 0x7F) << shift;
+			shift += 7;
+		} while (byte & 0x80);
+
+		const int type = stream.get();
+		if (type == std::ifstream::traits_type::eof() || type >= sf::Event::Count) throw std::runtime_error("Corrupt event recording file");
+
+		RecordedEvent recorded{};
+		timestamp += std::chrono::nanoseconds(delta);
+		recorded.timestamp = timestamp;
+		recorded.event.type = static_cast<sf::Event::EventType>(type);
+		const auto payload_size = detail::event_payload_size(recorded.event.type);
+		stream.read(reinterpret_cast<char*>(&recorded.event.size), payload_size);
+		if (static_cast<std::size_t>(stream.gcount()) != payload_size) throw std::runtime_error("Truncated event recording file");
+
+		events_.push_back(recorded);
+	}
+}
+
+/// \brief Replays the loaded events into a consumer
+/// \details The virtual time jumps to each event timestamp before the event is consumed, consumers read it
+/// through \sa EventReplayer::virtual_time(). With \sa Speed::Recorded the replay additionally sleeps until the
+/// recorded offset is reached. The per event timings cover the consumer and the step together
+/// \param consumer Receives each event, eg. a lambda calling \sa Window::process_event
+/// \param speed The pace of the replay
+/// \param step Optional callback invoked after each event with the virtual time, eg. to render a frame
+/// \returns The timings of the replay
+auto EventReplayer::replay(const consumer_t& consumer, const Speed speed, const step_t& step) -> Stats {
+	Stats stats;
+	const auto wall_start = steady_clock_t::now();
+	virtual_time_ = std::chrono::nanoseconds::zero();
+
+	for (const auto& [timestamp, event] : events_) {
+		if (speed == Speed::Recorded) std::this_thread::sleep_until(wall_start + timestamp);
+		virtual_time_ = timestamp;
+
+		const auto before = steady_clock_t::now();
+		consumer(event);
+		if (step) step(virtual_time_);
+		const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(steady_clock_t::now() - before);
+
+		stats.processing_duration += elapsed;
+		if (elapsed > stats.max_event_duration) stats.max_event_duration = elapsed;
+		++stats.event_count;
+	}
+
+	stats.recorded_duration = events_.empty() ? std::chrono::nanoseconds::zero() : events_.back().timestamp;
+	stats.wall_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(steady_clock_t::now() - wall_start);
+	return stats;
+}
+
+}	 // namespace cui
+
+#endif	  // CUI_SFML_EVENT_RECORDER_HPP
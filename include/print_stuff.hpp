@@ -168,7 +168,7 @@ std::ostream& operator<<(std::ostream& os, const cui::SceneGraph& sg) {
 		os << kvp.second << "\n\t";
 	}
 	os << "Active schematic\n\t\t";
-	os << sg.root().active_schematic().get();
+	os << sg.root().active_schematic();
 	os << "\n}";
 
 	for (std::size_t i = 0; i < sg.length(); ++i) {
@@ -185,7 +185,7 @@ std::ostream& operator<<(std::ostream& os, const cui::SceneGraph& sg) {
 			os << kvp.second << "\n\t";
 		}
 		os << "Active schematic\n\t\t";
-		os << node.data().active_schematic().get();
+		os << node.data().active_schematic();
 		os << "\n}";
 	}
 	return os;
@@ -5,22 +5,46 @@
 #include <cui/utils/print.hpp>
 
 #include <algorithm>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <aliases.hpp>
 #include <cui/utils/get_path_head.hpp>
 #include <cui/visual/node.hpp>
 #include <cui/visual/scene_graph.hpp>
 #include <detail/intermediaries/color.hpp>
-#include <detail/iterator_pair.hpp>
 #include <detail/utils/floor.hpp>
 #include <tsl/hopscotch_map.h>
 #include <visual_element.hpp>
 
 namespace cui {
 
+/// \brief Attributes of a \sa cui::VisualElement that can be refreshed without updating the whole cache
+enum class VisualAttribute : u8
+{
+	X,
+	Y,
+	Width,
+	Height,
+	Background,
+	TextColor,
+	Text
+};
+
+using visual_attributes_t = u8;
+
+/// \brief Mask requesting a refresh of every attribute of a node and its subtree
+constexpr visual_attributes_t all_visual_attributes = 0xFF;
+
+/// \brief Gets the bit of an attribute inside a \sa visual_attributes_t mask
+[[nodiscard]] constexpr auto attribute_bit(const VisualAttribute attribute) noexcept -> visual_attributes_t {
+	return static_cast<visual_attributes_t>(1u << static_cast<u8>(attribute));
+}
+
 /// \brief Class for transforming CUI attributes and rules into a \sa cui::VisualElement
-/// \details Holds all VEs in a \sa cui::Vector which gets sorted according to the \sa cui::SceneGraph node depths
+/// \details Holds all VEs in a \sa cui::Vector in the order of the \sa cui::SceneGraph nodes, behind the root element
 class RenderCache : public std::vector<VisualElement>
 {
 public:
@@ -28,8 +52,6 @@ public:
 		return this->size() - 1;
 	}
 
-	void sort(const SceneGraph& graph);
-
 	void cache_resource(Node& node);
 
 	void update_ve(const SceneGraph& graph, const Node& node, u64 index);
@@ -38,8 +60,14 @@ public:
 
 	void update_cache(const SceneGraph& graph);
 
-	void handle_background(Schematic& scheme, VisualElement& ve);
-	void handle_font(Schematic& scheme, VisualElement& ve);
+	void update_subtree(const SceneGraph& graph, u64 index);
+
+	void update_attributes(const SceneGraph& graph, u64 index, visual_attributes_t attributes);
+
+	void apply_remap(const SceneGraph& graph, const SceneGraph::remap_t& remap);
+
+	void handle_background(const Schematic& scheme, VisualElement& ve);
+	void handle_font(const Schematic& scheme, VisualElement& ve);
 	void handle_x(const Schematic& scheme, VisualElement& ve);
 	void handle_y(const Schematic& scheme, VisualElement& ve);
 	void handle_width(const Schematic& scheme, VisualElement& ve);
@@ -54,60 +82,70 @@ public:
 	void handle_rule_height(const VisualElement& parent_ve, const Schematic& scheme, VisualElement& ve);
 
 public:
-	tsl::hopscotch_map<std::string, sf::Texture> textures;
-	tsl::hopscotch_map<std::string, sf::Font> fonts;
+	// Elements point at the resources, hopscotch maps move their values so each resource lives on the heap
+	tsl::hopscotch_map<std::string, std::unique_ptr<sf::Texture>> textures;
+	tsl::hopscotch_map<std::string, std::unique_ptr<sf::Font>> fonts;
+	// The file each font was loaded from by its path head, lets the render thread load its own copy
+	tsl::hopscotch_map<std::string, std::string> font_files;
 };
 
 /// \brief Caches \sa cui::Node resources such as images and fonts
-/// \details Does not cache twice, the resource exists throughout the existence of the \sa cui::window
+/// \details Does not cache twice, the resource exists throughout the existence of the \sa cui::window and keeps
+/// its address when more resources are cached at runtime. Resource paths are replaced by their path head. The schematics are only written to when a path still has
+/// to be replaced, so nodes sharing their schematics stay shared
 /// \param node The node from which to cache resources
 void RenderCache::cache_resource(Node& node) {
-	{
-		auto& scheme = node.default_schematic();
-		auto& background = scheme.background();
-		auto& font = scheme.font();
-		if (background.is_string()) {
-			const auto path_head = get_path_head(background.string());
-			if (!textures.contains(path_head)) {
-				println("Added texture named:", path_head);
-				textures[path_head].loadFromFile(background.string());
-			}
-			background = path_head;
+	const auto cache_texture = [this](const ValueData& background) -> std::string {
+		const auto path_head = get_path_head(background.string());
+		if (!textures.contains(path_head)) {
+			println("Added texture named:", path_head);
+			auto texture = std::make_unique<sf::Texture>();
+			texture->loadFromFile(background.string());
+			textures.emplace(path_head, std::move(texture));
 		}
-		if (font.is_string()) {
-			const auto path_head = get_path_head(font.string());
-			if (!fonts.contains(path_head)) {
-				println("Added font named:", path_head);
-				fonts[path_head].loadFromFile(font.string());
-			}
-			font = path_head;
+		return path_head;
+	};
+	const auto cache_font = [this](const ValueData& font) -> std::string {
+		const auto path_head = get_path_head(font.string());
+		if (!fonts.contains(path_head)) {
+			println("Added font named:", path_head);
+			auto loaded = std::make_unique<sf::Font>();
+			loaded->loadFromFile(font.string());
+			fonts.emplace(path_head, std::move(loaded));
+			font_files[path_head] = font.string();
 		}
+		return path_head;
+	};
+
+	const auto cache_scheme = [&](const Schematic& scheme) -> bool {
+		auto rewrite = false;
+		if (scheme.background().is_string()) rewrite |= cache_texture(scheme.background()) != scheme.background().string();
+		if (scheme.font().is_string()) rewrite |= cache_font(scheme.font()) != scheme.font().string();
+		return rewrite;
+	};
+	const auto rewrite_scheme = [](Schematic& scheme) {
+		if (scheme.background().is_string()) scheme.background() = get_path_head(scheme.background().string());
+		if (scheme.font().is_string()) scheme.font() = get_path_head(scheme.font().string());
+	};
+
+	const auto& shared = std::as_const(node);
+	auto rewrite = cache_scheme(shared.default_schematic());
+	for (auto kvp_it = shared.event_schematics().begin(); kvp_it != shared.event_schematics().end(); ++kvp_it) {
+		rewrite |= cache_scheme(kvp_it->second);
 	}
+	if (!rewrite) return;
 
-	for (auto kvp_it = node.event_schematics().begin(); kvp_it != node.event_schematics().end(); ++kvp_it) {
-		auto& background = kvp_it.value().background();
-		auto& font = kvp_it.value().font();
-		if (background.is_string()) {
-			const auto path_head = get_path_head(background.string());
-			if (!textures.contains(path_head)) {
-				println("Added texture named:", path_head);
-				textures[path_head].loadFromFile(background.string());
-			}
-			background = path_head;
-		}
-		if (font.is_string()) {
-			const auto path_head = get_path_head(font.string());
-			if (!fonts.contains(path_head)) {
-				println("Added font named:", path_head);
-				fonts[path_head].loadFromFile(font.string());
-			}
-			font = path_head;
-		}
+	// Writing detaches the node, which replaces the maps, so the paths are only rewritten once the node owns them
+	rewrite_scheme(node.default_schematic());
+	auto& event_schematics = node.event_schematics();
+	for (auto kvp_it = event_schematics.begin(); kvp_it != event_schematics.end(); ++kvp_it) {
+		rewrite_scheme(kvp_it.value());
 	}
 }
 
 /// \brief Updates the cache
-/// \details Iterates through the graph and updates each \sa cui::VisualElement
+/// \details Iterates through the graph and updates each \sa cui::VisualElement. The cache stays in the order
+/// of the graph, element i + 1 belongs to node i
 void RenderCache::update_cache(const SceneGraph& graph) {
 	update_root(graph);
 
@@ -116,8 +154,82 @@ void RenderCache::update_cache(const SceneGraph& graph) {
 		const auto& node_data = graph[i].data();
 		update_ve(graph, node_data, i);
 	}
+}
 
-	sort(graph);
+/// \brief Updates a node and all of its descendants
+/// \details Used when a change to a node affects the layout of the nodes below it but nothing else
+/// \param graph The graph the node belongs to
+/// \param index The index of the node in the \sa cui::SceneGraph nodes vector
+void RenderCache::update_subtree(const SceneGraph& graph, const u64 index) {
+	std::vector<u64> pending{index};
+	while (!pending.empty()) {
+		const auto current = pending.back();
+		pending.pop_back();
+
+		const auto& node = graph[current];
+		update_ve(graph, node.data(), current);
+		pending.insert(pending.end(), node.children().rbegin(), node.children().rend());
+	}
+}
+
+/// \brief Refreshes individual attributes of a node
+/// \details Position, color and text changes of a leaf are written straight into its \sa cui::VisualElement.
+/// Size changes, and position changes of a node with children, update the subtree instead since rules of
+/// the descendants depend on them
+/// \param graph The graph the node belongs to
+/// \param index The index of the node in the \sa cui::SceneGraph nodes vector
+/// \param attributes The mask of the changed attributes
+void RenderCache::update_attributes(const SceneGraph& graph, const u64 index, const visual_attributes_t attributes) {
+	const auto& node = graph[index];
+	const auto position = attribute_bit(VisualAttribute::X) | attribute_bit(VisualAttribute::Y);
+	const auto size = attribute_bit(VisualAttribute::Width) | attribute_bit(VisualAttribute::Height);
+
+	if ((attributes & size) || ((attributes & position) && !node.children().empty())) {
+		update_subtree(graph, index);
+		return;
+	}
+
+	auto& ve = this->operator[](index + 1);
+	const auto& scheme = node.data().active_schematic();
+	if (attributes & attribute_bit(VisualAttribute::X)) handle_x(scheme, ve);
+	if (attributes & attribute_bit(VisualAttribute::Y)) handle_y(scheme, ve);
+	if (attributes & attribute_bit(VisualAttribute::Background)) handle_background(scheme, ve);
+	if (attributes & attribute_bit(VisualAttribute::TextColor)) handle_text_color(scheme, ve);
+	if (attributes & attribute_bit(VisualAttribute::Text)) ve.text().setString(node.data().text());
+	if (attributes & (position | attribute_bit(VisualAttribute::Text))) handle_text_position(scheme, ve);
+}
+
+/// \brief Follows a structural change of the graph
+/// \details Inserted nodes get a new \sa cui::VisualElement at their position and only their subtrees are
+/// updated, rules only depend on the parent so their siblings keep their layout. Removed nodes drop their
+/// elements in a single compacting pass without touching any other element
+/// \param graph The graph after the change
+/// \param remap The remap returned by \sa SceneGraph::insert_subtree() or \sa SceneGraph::remove_subtree()
+void RenderCache::apply_remap(const SceneGraph& graph, const SceneGraph::remap_t& remap) {
+	if (remap.empty()) return;
+
+	if (remap.is_insertion()) {
+		const auto first = remap.position();
+		const auto last = first + remap.inserted();
+		this->insert(this->begin() + static_cast<std::ptrdiff_t>(first + 1), remap.inserted(), VisualElement{});
+		for (auto i = first; i < last; ++i) {
+			const auto parent = graph[i].parent();
+			if (parent == SceneGraph::root_index || parent < first || parent >= last) update_subtree(graph, i);
+		}
+		return;
+	}
+
+	const auto& removed = remap.removed();
+	auto out = this->begin() + static_cast<std::ptrdiff_t>(removed.front() + 1);
+	auto next_removed = removed.begin();
+	for (auto i = removed.front(); i < len(); ++i) {
+		if (next_removed != removed.end() && *next_removed == i) {
+			++next_removed;
+			continue;
+		}
+		*out++ = std::move(this->operator[](i + 1));
+	}
+	this->erase(out, this->end());
 }
 
 /// \brief Updates the root node of the \sa cui::SceneGraph
@@ -129,22 +241,6 @@ void RenderCache::update_root(const SceneGraph& graph) {
 	update_ve(graph, root, SceneGraph::root_index);
 }
 
-/// \brief Sorts the cache according to the \sa cui::SceneGraph node depths
-/// \details Creates a zip iterator to the depths vector of the \sa cui::SceneGraph and
-/// the cache vector, then sorts it accordingly
-/// \param graph The graph from which to sort the cache
-void RenderCache::sort(const SceneGraph& graph) {
-	std::vector<std::size_t> v;
-	v.reserve(graph.length());
-	for (const auto& node : graph) {
-		v.push_back(node.depth());
-	}
-
-	auto begin = IteratorPair{v.begin(), this->begin()};
-	auto end = IteratorPair{v.end(), this->end()};
-	std::sort(begin, end, [&graph](const auto& lhs, const auto& rhs) { return lhs > rhs; });
-}
-
 /// \brief Updates the \sa cui::VisualElement according to the \sa cui::SceneGraph node attributes and rules
 /// \details Updates the entire \sa cui::VisualElement and does no attempt to figure out which ones do not need
 /// to be updated
@@ -153,7 +249,7 @@ void RenderCache::sort(const SceneGraph& graph) {
 /// \param index The index of the node in the \sa cui::SceneGraph nodes vector
 void RenderCache::update_ve(const SceneGraph& graph, const Node& node, const u64 index) {
 	auto& ve = this->operator[](index + 1);
-	auto& scheme = node.active_schematic().get();
+	const auto& scheme = node.active_schematic();
 	auto parent_index = graph.get_parent_index(index);
 	parent_index = parent_index == graph.length() ? 0 : parent_index + 1;
 	const auto& parent_ve = this->operator[](parent_index);
@@ -191,21 +287,21 @@ void RenderCache::update_ve(const SceneGraph& graph, const Node& node, const u64
 	handle_text_position(scheme, ve);
 }
 
-void RenderCache::handle_background(Schematic& scheme, VisualElement& ve) {
-	auto& val = scheme.background();
+void RenderCache::handle_background(const Schematic& scheme, VisualElement& ve) {
+	const auto& val = scheme.background();
 	// Add support for images later
 	if (val.is_string()) {
-		ve.setTexture(&textures.at(val.string()));
+		ve.setTexture(textures.at(val.string()).get());
 		return;
 	}
 	ve.setFillColor(intermediary::Color{val.rgba()});
 }
 
-void RenderCache::handle_font(Schematic& scheme, VisualElement& ve) {
-	auto& val = scheme.font();
+void RenderCache::handle_font(const Schematic& scheme, VisualElement& ve) {
+	const auto& val = scheme.font();
 	if (val.is_none()) return;
 
-	ve.text().setFont(fonts.at(val.string()));
+	ve.text().setFont(*fonts.at(val.string()));
 	return;
 }
 
@@ -0,0 +1,88 @@
+#ifndef CUI_SFML_UI_COMMAND_HPP
+#define CUI_SFML_UI_COMMAND_HPP
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <variant>
+
+#include <aliases.hpp>
+#include <cui/data_types/color.hpp>
+#include <render_cache.hpp>
+
+namespace cui {
+
+/// \brief A node mutation posted to the window thread
+/// \details Commands address nodes by name and are resolved when they are applied, so posting one from any
+/// thread never touches the scene graph. See \sa Window::post_command()
+class UiCommand
+{
+public:
+	enum class Kind : u8
+	{
+		SetText,
+		SwitchSchematic,
+		SetAttribute
+	};
+
+	using value_t = std::variant<std::monostate, std::string, int, Color>;
+
+	UiCommand() = default;
+
+	/// \brief Replaces the text of a node
+	[[nodiscard]] static auto set_text(std::string node, std::string text) -> UiCommand {
+		return UiCommand(Kind::SetText, std::move(node), VisualAttribute::Text, std::move(text));
+	}
+
+	/// \brief Activates an event schematic of a node, an empty name activates the default schematic
+	[[nodiscard]] static auto switch_schematic(std::string node, std::string schematic) -> UiCommand {
+		return UiCommand(Kind::SwitchSchematic, std::move(node), VisualAttribute::Text, std::move(schematic));
+	}
+
+	/// \brief Sets x, y, width or height of the active schematic of a node to an absolute value
+	/// \details Throws for the other attributes, they do not hold a number
+	[[nodiscard]] static auto set_attribute(std::string node, const VisualAttribute attribute, const int value) -> UiCommand {
+		if (attribute != VisualAttribute::X && attribute != VisualAttribute::Y && attribute != VisualAttribute::Width && attribute != VisualAttribute::Height) {
+			throw std::logic_error("Only x, y, width and height can be set to a number");
+		}
+		return UiCommand(Kind::SetAttribute, std::move(node), attribute, value);
+	}
+
+	/// \brief Sets background or text_color of the active schematic of a node
+	/// \details Throws for the other attributes, they do not hold a color
+	[[nodiscard]] static auto set_attribute(std::string node, const VisualAttribute attribute, const Color& value) -> UiCommand {
+		if (attribute != VisualAttribute::Background && attribute != VisualAttribute::TextColor) {
+			throw std::logic_error("Only background and text_color can be set to a color");
+		}
+		return UiCommand(Kind::SetAttribute, std::move(node), attribute, value);
+	}
+
+	[[nodiscard]] auto kind() const noexcept -> Kind {
+		return kind_;
+	}
+
+	[[nodiscard]] auto node() const noexcept -> const std::string& {
+		return node_;
+	}
+
+	[[nodiscard]] auto attribute() const noexcept -> VisualAttribute {
+		return attribute_;
+	}
+
+	[[nodiscard]] auto value() const noexcept -> const value_t& {
+		return value_;
+	}
+
+private:
+	UiCommand(const Kind p_kind, std::string&& p_node, const VisualAttribute p_attribute, value_t&& p_value)
+		: kind_(p_kind), node_(std::move(p_node)), attribute_(p_attribute), value_(std::move(p_value)) {}
+
+	Kind kind_ = Kind::SetText;
+	std::string node_;
+	VisualAttribute attribute_ = VisualAttribute::Text;
+	value_t value_;
+};
+
+}	 // namespace cui
+
+#endif	  // CUI_SFML_UI_COMMAND_HPP
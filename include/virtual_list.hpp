@@ -0,0 +1,189 @@
+#ifndef CUI_SFML_VIRTUAL_LIST_HPP
+#define CUI_SFML_VIRTUAL_LIST_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <aliases.hpp>
+#include <cui/visual/prototype.hpp>
+#include <cui/visual/scene_graph.hpp>
+
+namespace cui {
+
+/// \brief State of a list whose rows are only materialized while they intersect the viewport
+/// \details A node of the scene acts as the viewport of the list, the first child subtree it was declared with
+/// becomes the row template. The window keeps one instance of the template per visible row plus the overscan
+/// above and below, recycles them as the list scrolls and lets a bind callback fill them with the data of an
+/// item. Item i always lands in row slot i % \sa VirtualList::rows().size(), so scrolling only rebinds the
+/// rows of the items that became visible. Memory and layout cost depend on the viewport, not on the item count.
+/// Managed by \sa Window::virtualize()
+class VirtualList
+{
+public:
+	using size_type = std::size_t;
+	using prototype_t = Prototype;
+	using bind_t = std::function<void(size_type item, SceneGraph& graph, size_type row_index)>;
+	static constexpr size_type npos = -1;
+
+	/// \brief A materialized row, named after the list and its slot
+	struct Row
+	{
+		std::string name;
+		size_type item = npos;
+	};
+
+	/// \brief The items to materialize, [first, last)
+	struct Span
+	{
+		size_type first = 0;
+		size_type last = 0;
+
+		[[nodiscard]] auto size() const noexcept -> size_type {
+			return last - first;
+		}
+	};
+
+	VirtualList(std::string p_name, prototype_t&& p_row_template, size_type p_item_count, float p_row_height, size_type p_overscan, bind_t&& p_bind);
+
+	[[nodiscard]] auto span(float viewport_height) -> Span;
+
+	[[nodiscard]] auto row_name(size_type slot) const -> std::string {
+		return name_ + '#' + std::to_string(slot);
+	}
+
+	/// \brief Scrolls to an offset in pixels, clamped to the content on the next frame
+	void scroll_to(const float offset) noexcept {
+		scroll_offset_ = offset;
+		dirty_ = true;
+	}
+
+	void scroll_by(const float delta) noexcept {
+		this->scroll_to(scroll_offset_ + delta);
+	}
+
+	/// \brief Changes the amount of items, every row is bound again
+	void set_item_count(const size_type count) noexcept {
+		item_count_ = count;
+		this->invalidate();
+	}
+
+	/// \brief Makes every materialized row bind its item again on the next frame
+	void invalidate() noexcept {
+		for (auto& row : rows_) row.item = npos;
+		dirty_ = true;
+	}
+
+	/// \brief Makes the row of a single item bind again if it is materialized
+	void invalidate(const size_type item) noexcept {
+		for (auto& row : rows_) {
+			if (row.item == item) row.item = npos;
+		}
+		dirty_ = true;
+	}
+
+	[[nodiscard]] auto name() const noexcept -> const std::string& {
+		return name_;
+	}
+
+	[[nodiscard]] auto row_template() const noexcept -> const prototype_t& {
+		return row_template_;
+	}
+
+	[[nodiscard]] auto item_count() const noexcept -> size_type {
+		return item_count_;
+	}
+
+	[[nodiscard]] auto row_height() const noexcept -> float {
+		return row_height_;
+	}
+
+	[[nodiscard]] auto overscan() const noexcept -> size_type {
+		return overscan_;
+	}
+
+	[[nodiscard]] auto scroll_offset() const noexcept -> float {
+		return scroll_offset_;
+	}
+
+	[[nodiscard]] auto bind() const noexcept -> const bind_t& {
+		return bind_;
+	}
+
+	[[nodiscard]] auto rows() noexcept -> std::vector<Row>& {
+		return rows_;
+	}
+
+	[[nodiscard]] auto rows() const noexcept -> const std::vector<Row>& {
+		return rows_;
+	}
+
+	[[nodiscard]] auto dirty() noexcept -> bool& {
+		return dirty_;
+	}
+
+	[[nodiscard]] bool dirty() const noexcept {
+		return dirty_;
+	}
+
+private:
+	std::string name_;
+	prototype_t row_template_;
+	size_type item_count_;
+	float row_height_;
+	size_type overscan_;
+	bind_t bind_;
+	float scroll_offset_ = 0;
+	std::vector<Row> rows_;
+	bool dirty_ = true;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \param p_name The name of the node acting as the viewport
+/// \param p_row_template The nodes instantiated for every row
+/// \param p_item_count The amount of items
+/// \param p_row_height The height of a row in pixels, has to be positive
+/// \param p_overscan The amount of rows kept above and below the viewport
+/// \param p_bind Fills a row with the data of an item
+VirtualList::VirtualList(std::string p_name,
+						 prototype_t&& p_row_template,
+						 const size_type p_item_count,
+						 const float p_row_height,
+						 const size_type p_overscan,
+						 bind_t&& p_bind)
+	: name_(std::move(p_name)),
+	  row_template_(std::move(p_row_template)),
+	  item_count_(p_item_count),
+	  row_height_(p_row_height),
+	  overscan_(p_overscan),
+	  bind_(std::move(p_bind)) {
+	if (!(row_height_ > 0)) throw std::logic_error("The row height has to be positive");
+}
+
+/// \brief Computes the items to materialize for a viewport
+/// \details Clamps the scroll offset to the content first. The span covers the rows intersecting the viewport
+/// plus the overscan on both sides, shifted inwards at either end of the list so its size stays constant
+/// while scrolling
+/// \param viewport_height The height of the viewport node in pixels
+/// \returns The span of items
+auto VirtualList::span(const float viewport_height) -> Span {
+	const auto content_height = static_cast<float>(item_count_) * row_height_;
+	scroll_offset_ = std::clamp(scroll_offset_, 0.0f, std::max(0.0f, content_height - viewport_height));
+
+	const auto visible = static_cast<size_type>(std::ceil(std::max(0.0f, viewport_height) / row_height_)) + 1;
+	const auto wanted = std::min(item_count_, visible + 2 * overscan_);
+	const auto first_visible = static_cast<size_type>(scroll_offset_ / row_height_);
+
+	auto first = first_visible > overscan_ ? first_visible - overscan_ : 0;
+	first = std::min(first, item_count_ - wanted);
+	return {first, first + wanted};
+}
+
+}	 // namespace cui
+
+#endif	  // CUI_SFML_VIRTUAL_LIST_HPP
@@ -1,11 +1,16 @@
 #ifndef CUI_WINDOW_HPP
 #define CUI_WINDOW_HPP
 
+#include <algorithm>
 #include <any>
+#include <atomic>
 #include <condition_variable>
+#include <ctime>
 #include <functional>
+#include <limits>
+#include <memory>
 #include <mutex>
-#include <queue>
+#include <optional>
 #include <shared_mutex>
 #include <string_view>
 #include <thread>
@@ -13,15 +18,28 @@
 #include <vector>
 
 #include <aliases.hpp>
+#include <animator.hpp>
 #include <cui/compile_time/scene.hpp>
 #include <cui/compile_time/style.hpp>
+#include <coroutine.hpp>
 #include <cui/containers/tracked_list.hpp>
+#include <cui/visual/scene_diff.hpp>
 #include <cui/scene_state.hpp>
+#include <detail/clock.hpp>
 #include <detail/event_data.hpp>
+#include <detail/latency_histogram.hpp>
 #include <detail/node_cache.hpp>
+#include <detail/profiler.hpp>
 #include <detail/timer_event.hpp>
+#include <detail/timer_wheel.hpp>
+#include <detail/triple_buffer.hpp>
+#include <detail/worker_pool.hpp>
+#include <event_recorder.hpp>
 #include <moodycamel/concurrent_queue.hpp>
 #include <render_cache.hpp>
+#include <tsl/hopscotch_map.h>
+#include <ui_command.hpp>
+#include <virtual_list.hpp>
 #include <visual_element.hpp>
 #include <window_options.hpp>
 
@@ -30,6 +48,8 @@
 
 namespace cui {
 
+class Application;
+
 class Window
 {
 	// impl type checking for RenderContext and EventManager
@@ -44,6 +64,8 @@ public:
 	// Graph related typedefs
 	using scene_graph_t = SceneGraph;
 	using tree_node_t = typename scene_graph_t::data_type;
+	using tree_t = typename scene_graph_t::tree_t;
+	using remap_t = typename scene_graph_t::remap_t;
 
 	// Event related typedefs
 	using event_data_t = EventData<tree_node_t>;
@@ -51,15 +73,90 @@ public:
 	using timer_event_t = TimerEvent;
 	using timer_event_fn_t = typename timer_event_t::event_t;
 	using marker_t = sf::Event::EventType;
+	using node_predicate_t = std::function<bool(const tree_node_t&)>;
+
+	// Async event related typedefs
+	using task_handle_t = TaskHandle;
+	using async_event_data_t = EventSnapshot<tree_node_t>;
+	using async_event_t = std::function<void(const async_event_data_t&, const task_handle_t&)>;
+	using async_job_t = std::function<void(const task_handle_t&)>;
+	using ui_task_t = std::function<void()>;
+	using ui_command_t = UiCommand;
+
+	// Animation typedefs
+	using animator_t = Animator;
+	using animation_id_t = typename animator_t::animation_id_t;
+	using easing_t = typename animator_t::easing_t;
 
 	// Window typedefs
 	using window_t = sf::RenderWindow;
 	using window_ptr_t = std::unique_ptr<window_t>;
 	using cache_t = RenderCache;
-	using scene_t = SceneState<event_t, marker_t>;
+	using scene_t = SceneState<event_t, marker_t, sf::Event::Count>;
 
 	// Threading typedefs
-	using timer_queue_t = std::priority_queue<timer_event_t, std::vector<timer_event_t>, std::greater<timer_event_t>>;
+	using timer_wheel_t = TimerWheel;
+	using timer_handle_t = TimerHandle;
+	using latency_histogram_t = LatencyHistogram;
+	using worker_pool_t = WorkerPool;
+	using task_group_t = TaskGroup;
+
+	// Structural edit typedefs
+	using scene_diff_t = SceneDiff;
+
+	// Virtual list typedefs
+	using prototype_t = Prototype;
+	using virtual_list_t = VirtualList;
+	using virtual_bind_t = typename virtual_list_t::bind_t;
+
+	/// \brief Latencies of the timer events that ran on this window
+	/// \details schedule_to_run measures from the deadline to the start of the callback, dequeue_to_run from
+	/// the time the callback was taken off the timer wheel to its start
+	struct TimerLatency
+	{
+		latency_histogram_t schedule_to_run;
+		latency_histogram_t dequeue_to_run;
+	};
+
+	/// \brief The lock and wake-up of whoever sleeps on the timers of a window
+	/// \details Owned by the window, or shared between every window of an \sa cui::Application so a single
+	/// loop can sleep on all of their timers. Also guards the timer wheel of the window
+	struct TimerSignal
+	{
+		std::mutex mutex;
+		std::condition_variable cv;
+		bool awakened = false;
+	};
+
+	/// \brief A font of the \sa RenderCache as listed in a \sa Window::FrameSnapshot
+	struct FontSource
+	{
+		const sf::Font* font;
+		std::string name;
+		std::string file;
+	};
+
+	/// \brief Copy of the render records of a frame, handed from the UI thread to the render thread
+	/// \details Texts still point at the fonts of the \sa RenderCache, which the UI thread keeps rasterizing
+	/// glyphs into. The snapshot lists those fonts with their path heads and files so the render thread swaps in
+	/// its own copies. Textures are only read by the render thread and keep their address in the cache
+	struct FrameSnapshot
+	{
+		std::vector<VisualElement> elements;
+		std::vector<FontSource> fonts;
+		std::optional<time_point_t> input_time;
+	};
+
+	/// \brief Costs gathered during \sa Window::simulate()
+	struct SimulationStats
+	{
+		u64 frame_count = 0;
+		u64 timer_count = 0;
+		standard_duration_t simulated_duration{0};
+		std::chrono::nanoseconds wall_duration{0};
+		std::chrono::nanoseconds cpu_duration{0};
+		std::chrono::nanoseconds max_frame_duration{0};
+	};
 
 	// Event cache typedefs
 	using event_cache_t = tsl::hopscotch_map<std::string, std::any>;
@@ -77,6 +174,7 @@ public:
 	Window(Container<ct::Style>&& p_styles, Scenes&&... p_scenes) : scenes_{scene_graph_t{std::move(p_scenes), p_styles}...} {}
 
 	void init(const WindowOptions& options);
+	void init_shared(const WindowOptions& options, std::shared_ptr<WorkerPool> workers, std::shared_ptr<TimerSignal> signal);
 
 	void handle_events();
 
@@ -89,24 +187,103 @@ public:
 	void unregister_global_event(marker_t marker, const std::string& name);
 	void unregister_global_event(marker_t marker, std::string&& name);
 
+	void register_async_event(marker_t marker, const std::string& name, async_event_t&& event);
+	void register_async_global_event(marker_t marker, const std::string& name, async_event_t&& event);
+	void cancel_async_event(const std::string& name);
+	[[nodiscard]] auto resolve_caller(const async_event_data_t& event_data) noexcept -> tree_node_t*;
+	[[nodiscard]] auto restore_event(const async_event_data_t& event_data) noexcept -> std::optional<event_data_t>;
+
+	auto run_async(async_job_t&& job) -> task_handle_t;
+	void post_to_ui(ui_task_t&& task);
+	void post_to_ui(const task_handle_t& handle, ui_task_t&& task);
+	void apply_ui_tasks();
+	void post_command(ui_command_t&& command);
+	void apply_ui_commands();
+
 	void attach_event_to_node(const std::string& search_name, const std::string& event_name);
 	void attach_event_to_node(const std::string& search_name, std::string&& event_name);
 	void detach_event_from_node(const std::string& search_name, const std::string& event_name);
 	void detach_event_from_node(const std::string& search_name, std::string&& event_name);
+	auto attach_event_to_style(const std::string& style_name, const std::string& event_name) -> std::size_t;
+	auto attach_event_to_nodes(const node_predicate_t& predicate, const std::string& event_name) -> std::size_t;
+	auto detach_event_from_nodes(const node_predicate_t& predicate, const std::string& event_name) -> std::size_t;
+	void delegate_event_to_node(const std::string& search_name, const std::string& event_name);
+	void undelegate_event_from_node(const std::string& search_name, const std::string& event_name);
 
 	void dispatch_event(marker_t marker, const std::string& name, const event_data_t& event_data);
 	void dispatch_event(marker_t marker, const std::string& name);
 	void process_event(const sf::Event& event);
 
+	void start_recording(const std::string& path);
+	void stop_recording();
+	auto replay_events(EventReplayer& replayer, EventReplayer::Speed speed = EventReplayer::Speed::Maximum) -> EventReplayer::Stats;
+
 	template <typename Period>
-	void timer_dispatch_event(marker_t marker, const std::string& evt_name, duration_t<Period> duration);
-	void timer_execute_next_in_line();
-	[[nodiscard]] bool timer_wait_until_push() noexcept;
-	[[nodiscard]] bool timer_wait_for(standard_duration_t& previous);
+	auto timer_dispatch_event(marker_t marker, const std::string& evt_name, duration_t<Period> duration) -> timer_handle_t;
+	auto timer_dispatch_event_at(marker_t marker, const std::string& evt_name, time_point_t deadline) -> timer_handle_t;
+	template <typename Period>
+	auto timer_dispatch_repeating_event(marker_t marker, const std::string& evt_name, duration_t<Period> interval) -> timer_handle_t;
+	auto timer_schedule(time_point_t deadline, timer_event_fn_t&& fn, standard_duration_t interval = standard_duration_t::zero()) -> timer_handle_t;
+	void timer_submit(timer_event_t&& timer);
+	bool timer_cancel(const timer_handle_t& handle);
+
+	auto debounce(event_t&& event, standard_duration_t delay) -> event_t;
+	auto throttle(event_t&& event, standard_duration_t interval) -> event_t;
+	void timer_dispatch_due();
+	[[nodiscard]] bool timer_wait();
+	auto run_dispatched_timer_events() -> std::size_t;
+	auto run_due_timers() -> std::size_t;
+	void frame_wait(time_point_t next_frame);
+
+	void advance_clock(standard_duration_t duration);
+	auto simulate(standard_duration_t duration, standard_duration_t frame_interval) -> SimulationStats;
+
+	auto animate(const std::string& node_name,
+				 VisualAttribute attribute,
+				 float to,
+				 standard_duration_t duration,
+				 easing_t easing = easing::linear,
+				 ui_task_t&& on_finish = {}) -> animation_id_t;
+	auto animate(const std::string& node_name,
+				 VisualAttribute attribute,
+				 const Color& to,
+				 standard_duration_t duration,
+				 easing_t easing = easing::linear,
+				 ui_task_t&& on_finish = {}) -> animation_id_t;
+	bool cancel_animation(animation_id_t id);
+	void run_animations();
+
+#ifdef CUI_HAS_COROUTINES
+	auto delay(standard_duration_t duration) -> detail::DelayAwaiter<Window>;
+	auto next_frame() -> detail::NextFrameAwaiter<Window>;
+	template <typename Job>
+	auto run_on_worker(Job&& job) -> detail::WorkerAwaiter<Window, std::decay_t<Job>>;
+#endif
+
+	auto insert_subtree(const std::string& parent_name, tree_t&& subtree, std::size_t child_position = tree_t::npos) -> remap_t;
+	auto remove_subtree(const std::string& node_name) -> remap_t;
+	auto instantiate(const std::string& parent_name,
+					 const prototype_t& prototype,
+					 std::size_t count,
+					 const std::string& name,
+					 std::size_t child_position = tree_t::npos) -> remap_t;
+	void apply_diff(const scene_diff_t& diff);
+	auto patch(const tree_t& target) -> scene_diff_t;
+
+	auto virtualize(const std::string& list_name,
+					std::size_t item_count,
+					float row_height,
+					virtual_bind_t&& bind,
+					std::size_t overscan = 2) -> virtual_list_t&;
+	auto virtual_list(const std::string& list_name) -> virtual_list_t&;
+	void run_virtual_lists();
 
 	void schedule_to_update_cache();
 	void update_cache();
 	void render() noexcept;
+	void draw(const std::vector<VisualElement>& elements) noexcept;
+	void publish_frame();
+	void render_frames();
 	void resize(int w, int h);
 
 	[[nodiscard]] auto active_scene() noexcept -> scene_t& {
@@ -133,8 +310,81 @@ public:
 		return cache_;
 	}
 
+	[[nodiscard]] auto animator() noexcept -> animator_t& {
+		return animator_;
+	}
+
+	[[nodiscard]] auto animator() const noexcept -> const animator_t& {
+		return animator_;
+	}
+
+	[[nodiscard]] auto workers() noexcept -> std::shared_ptr<WorkerPool>& {
+		return workers_;
+	}
+
+	/// \brief Gets the per-task timing of the worker pool merged over every worker
+	[[nodiscard]] auto worker_stats() const -> worker_pool_t::Stats {
+		if (!workers_) throw std::logic_error("The window has not been initialized");
+		return workers_->stats();
+	}
+
+	[[nodiscard]] auto timer_budget() noexcept -> standard_duration_t& {
+		return timer_budget_;
+	}
+
+	[[nodiscard]] auto timer_budget() const noexcept -> standard_duration_t {
+		return timer_budget_;
+	}
+
+	/// \brief The longest sleep of an idle frame loop without a framerate limit, bounds the delay of new input
+	[[nodiscard]] auto idle_poll_interval() noexcept -> standard_duration_t& {
+		return idle_poll_interval_;
+	}
+
+	[[nodiscard]] auto idle_poll_interval() const noexcept -> standard_duration_t {
+		return idle_poll_interval_;
+	}
+
+	/// \brief Gets the timer latencies, only to be read on the window thread, eg. inside \sa Window::post_to_ui()
+	[[nodiscard]] auto timer_latency() const noexcept -> const TimerLatency& {
+		return timer_latency_;
+	}
+
+	void reset_timer_latency() noexcept {
+		timer_latency_.schedule_to_run.reset();
+		timer_latency_.dequeue_to_run.reset();
+	}
+
+	[[nodiscard]] auto clock() noexcept -> Clock& {
+		return clock_;
+	}
+
+	[[nodiscard]] auto clock() const noexcept -> const Clock& {
+		return clock_;
+	}
+
+	[[nodiscard]] bool inline_timers() const noexcept {
+		return inline_timers_;
+	}
+
+	[[nodiscard]] bool pipelined() const noexcept {
+		return pipelined_;
+	}
+
+	/// \brief Checks whether the next frame differs from the displayed one or input is waiting to be displayed
+	[[nodiscard]] bool needs_render() const noexcept {
+		return frame_dirty_ || frame_input_time_ || update_cache_flag_.load();
+	}
+
+	[[nodiscard]] bool has_pending_work() const noexcept;
+
+	[[nodiscard]] auto input_latency() -> latency_histogram_t {
+		std::unique_lock lock(input_latency_mutex_);
+		return input_latency_;
+	}
+
 	[[nodiscard]] bool is_running() noexcept {
-		return window_->isOpen();
+		return !close_requested_.load(std::memory_order_acquire) && window_->isOpen();
 	}
 
 	[[nodiscard]] auto window() noexcept -> window_ptr_t& {
@@ -146,29 +396,87 @@ public:
 	}
 
 	void close() {
+		if (pipelined_) {
+			close_requested_.store(true, std::memory_order_release);
+			return;
+		}
 		window_->close();
 	}
 
 	~Window() {
-		main_thread_.join();
-		timer_cv_.notify_one();
-		timer_thread_.join();
+		if (main_thread_.joinable()) main_thread_.join();
+		timer_signal_->cv.notify_one();
+		if (timer_thread_.joinable()) timer_thread_.join();
+		workers_.reset();
 
-		this->window_->setActive(true);
+		if (this->window_) this->window_->setActive(true);
 	}
 
 public:
-	std::mutex timer_mutex;
 	event_cache_t event_cache;
-	moodycamel::ConcurrentQueue<timer_event_fn_t> dispatched_timer_events;
+	moodycamel::ConcurrentQueue<timer_event_t> dispatched_timer_events;
+	moodycamel::ConcurrentQueue<ui_task_t> ui_tasks;
 
 private:
+	friend class Application;
+
+	auto track_async_task(const std::string& name, async_job_t&& job) -> task_handle_t;
+	void create_window(const WindowOptions& options);
+	[[nodiscard]] static auto profile_event(const std::string& name, event_t&& event) -> event_t;
+	void init_cache();
+	void apply_command(scene_graph_t& graph, const ui_command_t& command);
+	void record_input_latency(time_point_t input_time);
+	void run_frames(u32 framerate);
+	auto insert_subtree_at(std::size_t parent, tree_t&& subtree, std::size_t child_position = tree_t::npos) -> remap_t;
+	auto remove_subtree_at(std::size_t index) -> remap_t;
+	void sync_virtual_list(virtual_list_t& list);
+	void reposition_virtual_rows();
+
+	template <typename Sink>
+	void timer_advance(time_point_t now, Sink&& sink);
+	void merge_submitted_timers();
+	[[nodiscard]] bool publish_timer_wait(std::optional<time_point_t> until);
+	[[nodiscard]] bool has_posted_work() const noexcept;
+	void wake_frame_loop();
+
+	std::shared_ptr<WorkerPool> workers_;
+	EventRecorder recorder_;
+	tsl::hopscotch_map<std::string, std::vector<task_handle_t>> async_tasks_;
 	std::thread main_thread_;
 	std::thread timer_thread_;
-	timer_queue_t timer_queue_;
-	std::condition_variable timer_cv_;
-	bool timer_wait_awakened_;
-	bool update_cache_flag_;
+	Clock clock_;
+	timer_wheel_t timers_;
+	std::shared_ptr<TimerSignal> timer_signal_ = std::make_shared<TimerSignal>();
+	moodycamel::ConcurrentQueue<timer_event_t> submitted_timers_;
+	std::vector<timer_event_t> submitted_batch_ = std::vector<timer_event_t>(64);
+	std::atomic<u64> submitted_count_ = 0;
+	u64 merged_count_ = 0;
+	std::atomic<standard_duration_t::rep> timer_wake_at_ = std::numeric_limits<standard_duration_t::rep>::min();
+	bool inline_timers_ = false;
+	bool pipelined_ = false;
+	std::thread render_thread_;
+	std::atomic<bool> render_stop_ = false;
+	std::atomic<bool> close_requested_ = false;
+	TripleBuffer<FrameSnapshot> frames_;
+	std::mutex frames_mutex_;
+	std::condition_variable frames_cv_;
+	bool frame_dirty_ = true;
+	std::optional<time_point_t> frame_input_time_;
+	latency_histogram_t input_latency_;
+	std::mutex input_latency_mutex_;
+	standard_duration_t timer_budget_ = std::chrono::milliseconds(4);
+	standard_duration_t idle_poll_interval_ = std::chrono::milliseconds(4);
+	std::vector<timer_event_t> timer_batch_ = std::vector<timer_event_t>(64);
+	std::size_t timer_batch_begin_ = 0;
+	std::size_t timer_batch_end_ = 0;
+	TimerLatency timer_latency_;
+	animator_t animator_;
+	std::atomic<bool> update_cache_flag_ = false;
+	moodycamel::ConcurrentQueue<ui_command_t> ui_commands_;
+	std::vector<ui_command_t> command_batch_ = std::vector<ui_command_t>(64);
+	std::vector<visual_attributes_t> dirty_masks_;
+	std::vector<std::size_t> dirty_nodes_;
+	std::vector<std::unique_ptr<virtual_list_t>> virtual_lists_;
 	TrackedList<scene_t> scenes_;
 	RenderCache cache_;
 	std::unique_ptr<sf::RenderWindow> window_;
@@ -179,44 +487,137 @@ private:
 /// the threads
 /// \param options The options with which to construct the \sa sf::RenderWindow
 void Window::init(const WindowOptions& options) {
+	workers_ = std::make_shared<WorkerPool>(options.worker_count == 0 ? WorkerPool::default_worker_count() : options.worker_count);
+	inline_timers_ = options.inline_timers;
+	pipelined_ = options.pipelined;
+
 	main_thread_ = std::thread([this, &options] {
-		const auto& [w, h, title, style, ctx_settings, framerate] = options;
-		this->resize(w, h);
-		auto& graph = this->active_scene().graph();
-		this->window_ = std::make_unique<sf::RenderWindow>(sf::VideoMode(w, h), title, style, ctx_settings);
+		const auto framerate = options.framerate;
+		this->create_window(options);
+
+		if (this->pipelined_) {
+			this->window_->setFramerateLimit(framerate);
+			this->window_->setActive(false);
+			render_thread_ = std::thread([this] { this->render_frames(); });
 
-		this->cache_.cache_resource(graph.root());
-		for (auto& node : graph) {
-			this->cache_.cache_resource(node.data());
+			this->run_frames(framerate);
+
+			{
+				std::unique_lock lock(frames_mutex_);
+				render_stop_.store(true, std::memory_order_release);
+			}
+			frames_cv_.notify_one();
+			render_thread_.join();
+			this->window_->close();
+		} else if (this->inline_timers_) {
+			this->run_frames(framerate);
+		} else {
+			this->window_->setFramerateLimit(framerate);
+			timer_thread_ = std::thread([this] {
+				while (!this->timer_wait()) {
+					this->timer_dispatch_due();
+				}
+			});
+
+			while (this->is_running()) {
+				this->apply_ui_tasks();
+				this->apply_ui_commands();
+				this->handle_events();
+				this->run_dispatched_timer_events();
+				this->run_animations();
+				this->run_virtual_lists();
+				this->render();
+			}
 		}
+		this->window_->setActive(false);
+	});
+}
+
+/// \brief Initializes the window to be driven by an external loop
+/// \details Creates the \sa sf::RenderWindow on the calling thread without spawning any thread. Timers run
+/// inline like with \sa WindowOptions::inline_timers, the framerate and pipelining options are ignored. Used
+/// by \sa Application::add()
+/// \param options The options with which to construct the \sa sf::RenderWindow
+/// \param workers The worker pool shared with other windows
+/// \param signal The timer signal shared with other windows
+void Window::init_shared(const WindowOptions& options, std::shared_ptr<WorkerPool> workers, std::shared_ptr<TimerSignal> signal) {
+	workers_ = std::move(workers);
+	timer_signal_ = std::move(signal);
+	inline_timers_ = true;
+	pipelined_ = false;
+
+	this->create_window(options);
+	this->window_->setActive(false);
+}
+
+/// \brief Creates the \sa sf::RenderWindow and fills the cache
+/// \param options The options with which to construct the \sa sf::RenderWindow
+void Window::create_window(const WindowOptions& options) {
+	const auto& [w, h, title, style, ctx_settings, framerate, worker_count, inline_timers, pipelined] = options;
+	this->resize(w, h);
+	this->window_ = std::make_unique<sf::RenderWindow>(sf::VideoMode(w, h), title, style, ctx_settings);
+	this->init_cache();
+
+	for (const auto& ve : this->cache()) {
+		println(ve);
+	}
+	this->update_cache_flag_ = false;
+}
+
+/// \brief Caches the resources of the active scene and fills the \sa RenderCache
+void Window::init_cache() {
+	auto& graph = this->active_scene().graph();
+	cache_.cache_resource(graph.root());
+	for (auto& node : graph) {
+		cache_.cache_resource(node.data());
+	}
 
-		this->cache_.reserve(graph.length() + 1);
-		this->cache_.emplace_back();
-		this->cache_.update_cache(graph);
+	cache_.reserve(graph.length() + 1);
+	cache_.emplace_back();
+	cache_.update_cache(graph);
+}
 
-		for (const auto& ve : this->cache()) {
-			println(ve);
+/// \brief Runs the frame loop with timers integrated into it
+/// \details Used instead of the timer thread when \sa WindowOptions::inline_timers or
+/// \sa WindowOptions::pipelined is set. The loop paces the frames itself and sleeps until the next frame or
+/// the earliest timer deadline, whichever comes first. Timers scheduled and UI mutations posted from other
+/// threads wake it early. Without a limit, frames run back to back only while \sa Window::has_pending_work()
+/// and the idle loop sleeps until the next timer deadline, polling the window for input every
+/// \sa Window::idle_poll_interval(). Due timers run inline without a queue hop. When pipelined, frames are
+/// published to the render thread instead of rendered
+/// \param framerate The frame limit, zero for no limit
+void Window::run_frames(const u32 framerate) {
+	const auto frame_interval = framerate == 0 ? standard_duration_t::zero()
+											   : std::chrono::duration_cast<standard_duration_t>(std::chrono::seconds(1)) / framerate;
+	const auto uncapped = frame_interval == standard_duration_t::zero();
+	auto next_frame = clock_.now();
+
+	while (this->is_running()) {
+		this->apply_ui_tasks();
+		this->apply_ui_commands();
+		this->handle_events();
+		this->run_due_timers();
+
+		const auto now = clock_.now();
+		if (uncapped && !this->has_pending_work()) {
+			this->frame_wait(now + idle_poll_interval_);
+			continue;
 		}
-		this->window_->setFramerateLimit(framerate);
-		this->update_cache_flag_ = false;
 
-		timer_thread_ = std::thread([this] {
-			auto prev = standard_duration_t::zero();
-			while (true) {
-				if (this->timer_wait_until_push()) return;
-				if (this->timer_wait_for(prev)) continue;
-				this->timer_execute_next_in_line();
+		if (now >= next_frame) {
+			this->run_animations();
+			this->run_virtual_lists();
+			if (pipelined_) {
+				this->publish_frame();
+			} else {
+				this->render();
 			}
-		});
-
-		while (this->is_running()) {
-			this->handle_events();
-			timer_event_fn_t event;
-			if (this->dispatched_timer_events.try_dequeue(event)) event();
-			this->render();
+			next_frame += frame_interval;
+			if (next_frame < now) next_frame = now + frame_interval;
 		}
-		this->window_->setActive(false);
-	});
+
+		if (!uncapped) this->frame_wait(next_frame);
+	}
 }
 
 /// \brief Resizes the window
@@ -238,10 +639,13 @@ void Window::resize(const int w, const int h) {
 
 /// \brief Handles incoming events
 /// \details Lets the window poll for events and then passes each enqueued event to
-/// \sa Window::process_event(const sf::Event& event)
+/// \sa Window::process_event(const sf::Event& event). The time of the first event of a frame is kept to
+/// measure the input latency once the frame is displayed
 void Window::handle_events() {
+	CUI_PROFILE_SCOPE("handle_events");
 	sf::Event event;
 	while (window_->pollEvent(event)) {
+		if (!frame_input_time_) frame_input_time_ = steady_clock_t::now();
 		this->process_event(event);
 	}
 }
@@ -252,7 +656,7 @@ void Window::handle_events() {
 /// \param marker Marks the event to be looked up on a specific \sa sf::Event
 /// \param event The function that executes during dispatch
 void Window::register_event(const marker_t marker, const std::string& name, event_t&& event) {
-	this->active_scene().register_event(marker, name, std::move(event));
+	this->active_scene().register_event(marker, name, profile_event(name, std::move(event)));
 }
 
 /// \brief Registers an event available to nodes
@@ -261,7 +665,8 @@ void Window::register_event(const marker_t marker, const std::string& name, even
 /// \param marker Marks the event to be looked up on a specific \sa sf::Event
 /// \param event The function that executes during dispatch
 void Window::register_event(const marker_t marker, std::string&& name, event_t&& event) {
-	this->active_scene().register_event(marker, name, std::move(event));
+	auto profiled = profile_event(name, std::move(event));
+	this->active_scene().register_event(marker, std::move(name), std::move(profiled));
 }
 
 /// \brief Registers a global event
@@ -270,7 +675,7 @@ void Window::register_event(const marker_t marker, std::string&& name, event_t&&
 /// \param marker Marks the event to be looked up on a specific \sa sf::Event
 /// \param event The function that executes during dispatch
 void Window::register_global_event(marker_t marker, const std::string& name, event_t&& event) {
-	this->active_scene().register_global_event(marker, name, std::move(event));
+	this->active_scene().register_global_event(marker, name, profile_event(name, std::move(event)));
 }
 
 /// \brief Registers a global event
@@ -279,7 +684,25 @@ void Window::register_global_event(marker_t marker, const std::string& name, eve
 /// \param marker Marks the event to be looked up on a specific \sa sf::Event
 /// \param event The function that executes during dispatch
 void Window::register_global_event(marker_t marker, std::string&& name, event_t&& event) {
-	this->active_scene().register_global_event(marker, std::move(name), std::move(event));
+	auto profiled = profile_event(name, std::move(event));
+	this->active_scene().register_global_event(marker, std::move(name), std::move(profiled));
+}
+
+/// \brief Wraps an event into a profiler scope named after it
+/// \details The name is interned once at registration, so dispatching costs no lock or lookup. Returns the
+/// event unchanged unless CUI_ENABLE_PROFILER is defined
+/// \param name The name for the event, eg. on_btn_click, on_packet_receive, ...
+/// \param event The function that executes during dispatch
+/// \returns The event to register
+auto Window::profile_event([[maybe_unused]] const std::string& name, event_t&& event) -> event_t {
+#ifdef CUI_ENABLE_PROFILER
+	return [label = Profiler::instance().intern(name), fn = std::move(event)](event_data_t event_data) {
+		CUI_PROFILE_SCOPE(label);
+		fn(std::move(event_data));
+	};
+#else
+	return std::move(event);
+#endif
 }
 
 /// \brief Unregisters an event
@@ -314,72 +737,328 @@ void Window::unregister_global_event(const marker_t marker, std::string&& name)
 	this->active_scene().unregister_global_event(marker, std::move(name));
 }
 
-/// \brief Attaches a registered event to a node
-/// \details Searches for the node by name. If no node is found, an exception is thrown
-/// \param search_name The name of the node to search for
-/// \param event_name The name of the event that's being attached
-void Window::attach_event_to_node(const std::string& search_name, const std::string& event_name) {
+/// \brief Registers a node-local event whose function runs on the worker pool
+/// \details The dispatch only hands an owned snapshot of the event data to a worker, so a slow function does
+/// not stall rendering. The snapshot holds no pointers into the scene graph; any UI mutation the function
+/// produces must be posted through \sa Window::post_to_ui(), where \sa Window::resolve_caller() finds the caller
+/// \param marker Marks the event to be looked up on a specific \sa sf::Event
+/// \param name The name for the event, eg. on_btn_click, on_packet_receive, ...
+/// \param event The function that executes on a worker thread during dispatch
+void Window::register_async_event(const marker_t marker, const std::string& name, async_event_t&& event) {
+	this->register_event(marker, name, [this, name, fn = std::move(event)](event_data_t event_data) {
+		async_event_data_t snapshot(event_data, this->active_scene().graph().generation());
+		this->track_async_task(name, [fn, snapshot = std::move(snapshot)](const task_handle_t& handle) { fn(snapshot, handle); });
+	});
+}
+
+/// \brief Registers a global event whose function runs on the worker pool
+/// \details See \sa Window::register_async_event()
+/// \param marker Marks the event to be looked up on a specific \sa sf::Event
+/// \param name The name for the event, eg. on_btn_click, on_packet_receive, ...
+/// \param event The function that executes on a worker thread during dispatch
+void Window::register_async_global_event(const marker_t marker, const std::string& name, async_event_t&& event) {
+	this->register_global_event(marker, name, [this, name, fn = std::move(event)](event_data_t event_data) {
+		async_event_data_t snapshot(event_data, this->active_scene().graph().generation());
+		this->track_async_task(name, [fn, snapshot = std::move(snapshot)](const task_handle_t& handle) { fn(snapshot, handle); });
+	});
+}
+
+/// \brief Looks up the caller of an async event in the active scene
+/// \details The stored index is used while the graph has the generation of the snapshot, after a structural
+/// change the caller is looked up by name. Must be called on the UI thread, eg. from \sa Window::post_to_ui()
+/// \param event_data The snapshot an async handler received
+/// \returns The caller or a nullptr if the event had none or the node no longer exists
+auto Window::resolve_caller(const async_event_data_t& event_data) noexcept -> tree_node_t* {
+	if (!event_data.has_caller()) return nullptr;
+
 	auto& graph = this->active_scene().graph();
+	if (event_data.generation() != graph.generation()) return graph.find_node(event_data.caller_name());
+	if (event_data.caller_index() == scene_graph_t::root_index) return &graph.root();
+	return &graph[event_data.caller_index()].data();
+}
 
-	if (graph.root().name() == search_name) {
-		graph.root().attach_event(event_name);
-		return;
+/// \brief Rebuilds the event data of a snapshot against the active scene
+/// \details The stored indices are used while the graph has the generation of the snapshot, after a structural
+/// change the caller is looked up by name. A delegated target cannot be looked up, so delegated events are
+/// dropped after a structural change. The event name of the result views into the snapshot. Must be called on
+/// the UI thread
+/// \param event_data The snapshot taken when the event was dispatched
+/// \returns The event data or nothing if its caller no longer exists
+auto Window::restore_event(const async_event_data_t& event_data) noexcept -> std::optional<event_data_t> {
+	if (!event_data.has_caller()) return event_data_t(event_data.get(), event_data.event_name());
+
+	auto& graph = this->active_scene().graph();
+	auto caller_index = event_data.caller_index();
+	auto target_index = event_data.target_index();
+	if (event_data.generation() != graph.generation()) {
+		if (event_data.is_delegated()) return std::nullopt;
+		const auto index = graph.find_index(event_data.caller_name());
+		if (!index) return std::nullopt;
+		caller_index = target_index = *index;
 	}
 
-	auto it = std::find_if(graph.begin(), graph.end(), [search_name](const auto& node) { return node.data().name() == search_name; });
-	if (it == graph.end()) throw std::logic_error("No node found by that name");
-	it->data().attach_event(event_name);
+	auto* caller = caller_index == scene_graph_t::root_index ? &graph.root() : &graph[caller_index].data();
+	return event_data_t(event_data.get(), caller, caller_index, target_index, event_data.event_name());
 }
 
-/// \brief Attaches a registered event to a node
-/// \details Searches for the node by name. If no node is found, an exception is thrown
-/// \param search_name The name of the node to search for
-/// \param event_name The name of the event that's being attached
-void Window::attach_event_to_node(const std::string& search_name, std::string&& event_name) {
+/// \brief Cancels every in-flight task started by an async event
+/// \details Must be called from the UI thread, eg. from another event
+/// \param name The name of the async event
+void Window::cancel_async_event(const std::string& name) {
+	const auto it = async_tasks_.find(name);
+	if (it == async_tasks_.end()) return;
+
+	for (const auto& handle : it->second) handle.cancel();
+	async_tasks_.erase(it);
+}
+
+/// \brief Runs a job on the worker pool
+/// \details The job is skipped if it gets cancelled before a worker picks it up
+/// \param job The job to run, receives its own handle to poll for cancellation
+/// \returns The cancellation handle of the job
+auto Window::run_async(async_job_t&& job) -> task_handle_t {
+	if (!workers_) throw std::logic_error("The window has not been initialized");
+
+	task_handle_t handle;
+	workers_->submit([handle, fn = std::move(job)] {
+		if (!handle.cancelled()) fn(handle);
+		handle.mark_done();
+	});
+	return handle;
+}
+
+/// \brief Posts a UI mutation to be applied at the start of the next frame
+/// \details Safe to call from any thread
+/// \param task The mutation to apply on the UI thread
+void Window::post_to_ui(ui_task_t&& task) {
+	ui_tasks.enqueue(std::move(task));
+	this->wake_frame_loop();
+}
+
+/// \brief Posts a UI mutation of an async task to be applied at the start of the next frame
+/// \details Safe to call from any thread. The mutation is dropped if the task is cancelled before it is applied
+/// \param handle The handle of the task producing the mutation
+/// \param task The mutation to apply on the UI thread
+void Window::post_to_ui(const task_handle_t& handle, ui_task_t&& task) {
+	ui_tasks.enqueue([handle, fn = std::move(task)] {
+		if (!handle.cancelled()) fn();
+	});
+	this->wake_frame_loop();
+}
+
+/// \brief Applies the UI mutations posted since the last frame
+/// \details Only mutations that were enqueued before the call are applied, so a mutation posting
+/// another one cannot stall the frame
+void Window::apply_ui_tasks() {
+	auto pending = ui_tasks.size_approx();
+	ui_task_t task;
+	while (pending-- > 0 && ui_tasks.try_dequeue(task)) task();
+}
+
+/// \brief Posts a node mutation to be applied at the start of the next frame
+/// \details Safe to call from any thread, lock-free
+/// \param command The mutation, eg. \sa UiCommand::set_text()
+void Window::post_command(ui_command_t&& command) {
+	ui_commands_.enqueue(std::move(command));
+	this->wake_frame_loop();
+}
+
+/// \brief Applies the posted node mutations in a batch
+/// \details Every touched node is marked dirty with the attributes its commands changed, so many commands on
+/// the same node result in a single refresh of that node. Text, position and color changes of leaves are
+/// written straight into the \sa RenderCache, schematic switches and size changes update the subtree of the
+/// node. Nothing is refreshed per node if a full cache update is scheduled anyway
+void Window::apply_ui_commands() {
+	CUI_PROFILE_SCOPE("apply_ui_commands");
 	auto& graph = this->active_scene().graph();
+	if (dirty_masks_.size() < graph.length()) dirty_masks_.resize(graph.length(), 0);
 
-	if (graph.root().name() == search_name) {
-		graph.root().attach_event(event_name);
-		return;
+	while (const auto count = ui_commands_.try_dequeue_bulk(command_batch_.begin(), command_batch_.size())) {
+		for (std::size_t i = 0; i < count; ++i) {
+			this->apply_command(graph, command_batch_[i]);
+			command_batch_[i] = ui_command_t{};
+		}
+	}
+	if (dirty_nodes_.empty()) return;
+
+	const auto full_update = update_cache_flag_.load();
+	for (const auto index : dirty_nodes_) {
+		if (!full_update) cache_.update_attributes(graph, index, dirty_masks_[index]);
+		dirty_masks_[index] = 0;
+	}
+	dirty_nodes_.clear();
+	if (!full_update) this->reposition_virtual_rows();
+	frame_dirty_ = true;
+}
+
+/// \brief Applies a single node mutation to the scene graph and marks the node dirty
+/// \details Commands addressing an unknown node or schematic are dropped, the posting thread cannot be notified
+/// \param graph The graph of the active scene
+/// \param command The mutation
+void Window::apply_command(scene_graph_t& graph, const ui_command_t& command) {
+	const auto index = graph.find_index(command.node());
+	if (!index || *index == scene_graph_t::root_index) return;
+
+	auto& node = graph[*index].data();
+	visual_attributes_t attributes = 0;
+
+	switch (command.kind()) {
+		case ui_command_t::Kind::SetText: {
+			node.text() = std::get<std::string>(command.value());
+			attributes = attribute_bit(VisualAttribute::Text);
+			break;
+		}
+		case ui_command_t::Kind::SwitchSchematic: {
+			if (!node.set_active(std::get<std::string>(command.value()))) return;
+			attributes = all_visual_attributes;
+			break;
+		}
+		case ui_command_t::Kind::SetAttribute: {
+			auto& scheme = node.active_schematic().get();
+			if (const auto* value = std::get_if<int>(&command.value())) {
+				animator_t::apply(scheme, command.attribute(), animator_t::numeric(static_cast<float>(*value)));
+			} else if (const auto* color = std::get_if<Color>(&command.value())) {
+				animator_t::apply(scheme, command.attribute(), animator_t::color(*color));
+			}
+			attributes = attribute_bit(command.attribute());
+			break;
+		}
 	}
 
-	auto it = std::find_if(graph.begin(), graph.end(), [search_name](const auto& node) { return node.data().name() == search_name; });
-	if (it == graph.end()) throw std::logic_error("No node found by that name");
-	it->data().attach_event(std::move(event_name));
+	if (dirty_masks_[*index] == 0) dirty_nodes_.push_back(*index);
+	dirty_masks_[*index] |= attributes;
+}
+
+/// \brief Starts an async job and tracks its handle under the event name
+/// \details Handles of finished jobs are pruned on every call
+/// \param name The name of the async event
+/// \param job The job to run on the worker pool
+/// \returns The cancellation handle of the job
+auto Window::track_async_task(const std::string& name, async_job_t&& job) -> task_handle_t {
+	auto& handles = async_tasks_[name];
+	handles.erase(std::remove_if(handles.begin(), handles.end(), [](const auto& handle) { return handle.done(); }), handles.end());
+	handles.push_back(this->run_async(std::move(job)));
+	return handles.back();
+}
+
+/// \brief Attaches a registered event to a node
+/// \details Looks the node up in the name index. If no node is found, an exception is thrown
+/// \param search_name The name of the node to search for
+/// \param event_name The name of the event that's being attached
+void Window::attach_event_to_node(const std::string& search_name, const std::string& event_name) {
+	auto* node = this->active_scene().graph().find_node(search_name);
+	if (node == nullptr) throw std::logic_error("No node found by that name");
+	node->attach_event(event_name);
+}
+
+/// \brief Attaches a registered event to a node
+/// \details Looks the node up in the name index. If no node is found, an exception is thrown
+/// \param search_name The name of the node to search for
+/// \param event_name The name of the event that's being attached
+void Window::attach_event_to_node(const std::string& search_name, std::string&& event_name) {
+	auto* node = this->active_scene().graph().find_node(search_name);
+	if (node == nullptr) throw std::logic_error("No node found by that name");
+	node->attach_event(std::move(event_name));
 }
 
 /// \brief Detaches a registered event from a node
-/// \details Searches for the node by name. If no node is found, an exception is thrown
+/// \details Looks the node up in the name index. If no node is found, an exception is thrown
 /// \param search_name The name of the node to search for
 /// \param event_name The name of the event that is being detached
 void Window::detach_event_from_node(const std::string& search_name, const std::string& event_name) {
+	auto* node = this->active_scene().graph().find_node(search_name);
+	if (node == nullptr) throw std::logic_error("No node found by that name");
+	node->detach_event(event_name);
+}
+
+/// \brief Detaches a registered event from a node
+/// \details Looks the node up in the name index. If no node is found, an exception is thrown
+/// \param search_name The name of the node to search for
+/// \param event_name The name of the event that is being detached
+void Window::detach_event_from_node(const std::string& search_name, std::string&& event_name) {
+	auto* node = this->active_scene().graph().find_node(search_name);
+	if (node == nullptr) throw std::logic_error("No node found by that name");
+	node->detach_event(std::move(event_name));
+}
+
+/// \brief Attaches a registered event to every node a style class was applied to
+/// \details Uses the style class index of the graph, so only the styled nodes are visited
+/// \param style_name The name of the style class
+/// \param event_name The name of the event that's being attached
+/// \returns The amount of nodes the event got attached to
+auto Window::attach_event_to_style(const std::string& style_name, const std::string& event_name) -> std::size_t {
 	auto& graph = this->active_scene().graph();
+	const auto& indices = graph.indices_with_style(style_name);
+	for (const auto idx : indices) graph[idx].data().attach_event(event_name);
 
-	if (graph.root().name() == search_name) {
-		graph.root().detach_event(event_name);
-		return;
+	return indices.size();
+}
+
+/// \brief Attaches a registered event to every node matching a predicate
+/// \details Visits the root and every node of the graph once
+/// \param predicate Decides whether the event is attached to a node
+/// \param event_name The name of the event that's being attached
+/// \returns The amount of nodes the event got attached to
+auto Window::attach_event_to_nodes(const node_predicate_t& predicate, const std::string& event_name) -> std::size_t {
+	auto& graph = this->active_scene().graph();
+	std::size_t count = 0;
+
+	if (predicate(graph.root())) {
+		graph.root().attach_event(event_name);
+		++count;
+	}
+	for (auto& node : graph) {
+		if (!predicate(node.data())) continue;
+		node.data().attach_event(event_name);
+		++count;
 	}
 
-	auto it = std::find_if(graph.begin(), graph.end(), [search_name](const auto& node) { return node.data().name() == search_name; });
-	if (it == graph.end()) throw std::logic_error("No node found by that name");
-	it->data().detach_event(event_name);
+	return count;
 }
 
-/// \brief Detaches a registered event from a node
-/// \details Searches for the node by name. If no node is found, an exception is thrown
-/// \param search_name The name of the node to search for
+/// \brief Detaches a registered event from every node matching a predicate
+/// \details Visits the root and every node of the graph once
+/// \param predicate Decides whether the event is detached from a node
 /// \param event_name The name of the event that is being detached
-void Window::detach_event_from_node(const std::string& search_name, std::string&& event_name) {
+/// \returns The amount of nodes the event got detached from
+auto Window::detach_event_from_nodes(const node_predicate_t& predicate, const std::string& event_name) -> std::size_t {
 	auto& graph = this->active_scene().graph();
+	std::size_t count = 0;
 
-	if (graph.root().name() == search_name) {
-		graph.root().detach_event(std::move(event_name));
-		return;
+	if (predicate(graph.root())) {
+		graph.root().detach_event(event_name);
+		++count;
 	}
+	for (auto& node : graph) {
+		if (!predicate(node.data())) continue;
+		node.data().detach_event(event_name);
+		++count;
+	}
+
+	return count;
+}
+
+/// \brief Delegates a registered event to a container node
+/// \details The event fires once on the container whenever the hit-tested target is one of its
+/// descendants, with \sa EventData::target_index() set to the target. A target that has the event attached
+/// itself handles it and the container is skipped. Searches for the node by name. If no node is found, an
+/// exception is thrown
+/// \param search_name The name of the container node to search for
+/// \param event_name The name of the event that's being delegated
+void Window::delegate_event_to_node(const std::string& search_name, const std::string& event_name) {
+	auto* node = this->active_scene().graph().find_node(search_name);
+	if (node == nullptr) throw std::logic_error("No node found by that name");
+	node->delegate_event(event_name);
+}
 
-	auto it = std::find_if(graph.begin(), graph.end(), [search_name](const auto& node) { return node.data().name() == search_name; });
-	if (it == graph.end()) throw std::logic_error("No node found by that name");
-	it->data().detach_event(std::move(event_name));
+/// \brief Removes a delegated event from a container node
+/// \details Searches for the node by name. If no node is found, an exception is thrown
+/// \param search_name The name of the container node to search for
+/// \param event_name The name of the event that's being undelegated
+void Window::undelegate_event_from_node(const std::string& search_name, const std::string& event_name) {
+	auto* node = this->active_scene().graph().find_node(search_name);
+	if (node == nullptr) throw std::logic_error("No node found by that name");
+	node->undelegate_event(event_name);
 }
 
 /// \brief Dispatches an event with event data
@@ -389,65 +1068,890 @@ void Window::detach_event_from_node(const std::string& search_name, std::string&
 /// \param name The name for the event, eg. on_btn_click, on_packet_receive, ...
 /// \param event_data The event data (eg. received from sf::Event::Resized)
 void Window::dispatch_event(const marker_t marker, const std::string& name, const event_data_t& event_data) {
+	auto& scene = this->active_scene();
+	const scene_t::DispatchScope dispatch_scope(scene);
 	if (event_data.has_caller()) {
-		this->active_scene().get_event(marker, name)(event_data);
+		scene.get_event(marker, name)(event_data);
 	} else {
-		this->active_scene().get_global_event(marker, name)(event_data);
+		scene.get_global_event(marker, name)(event_data);
 	}
 }
 
 /// \brief Dispatches a timer event
-/// \details Pushes the event onto the timer event queue which then waits to execute
-/// until its wait duration passes
+/// \details Schedules the event on the timer wheel at an absolute deadline relative to now
 /// \tparam Period A template parameter to accept any \sa std::ratio for the duration
 /// \param marker Marks the event to be looked up on a specific \sa sf::Event
 /// \param name The name for the event, eg. on_btn_click, on_packet_receive, ...
 /// \param duration The duration for the timer event to wait until executed
+/// \returns The handle used to cancel the timer event
+template <typename Period>
+auto Window::timer_dispatch_event(const marker_t marker, const std::string& name, duration_t<Period> duration) -> timer_handle_t {
+	return this->timer_dispatch_event_at(marker, name, clock_.now() + std::chrono::duration_cast<standard_duration_t>(duration));
+}
+
+/// \brief Dispatches a timer event at an absolute deadline
+/// \param marker Marks the event to be looked up on a specific \sa sf::Event
+/// \param name The name for the event, eg. on_btn_click, on_packet_receive, ...
+/// \param deadline The time at which the timer event is executed
+/// \returns The handle used to cancel the timer event
+auto Window::timer_dispatch_event_at(const marker_t marker, const std::string& name, const time_point_t deadline) -> timer_handle_t {
+	return this->timer_schedule(deadline, [event = this->active_scene().get_event(marker, name)] { event(event_data_t{}); });
+}
+
+/// \brief Dispatches a timer event that repeats until cancelled
+/// \details The first execution happens one interval from now, every following one stays on the same
+/// interval grid regardless of how late the previous one ran
+/// \tparam Period A template parameter to accept any \sa std::ratio for the duration
+/// \param marker Marks the event to be looked up on a specific \sa sf::Event
+/// \param name The name for the event, eg. on_btn_click, on_packet_receive, ...
+/// \param interval The duration between executions
+/// \returns The handle used to cancel the timer event
 template <typename Period>
-void Window::timer_dispatch_event(const marker_t marker, const std::string& name, duration_t<Period> duration) {
-	std::unique_lock lock(timer_mutex);
-	const bool was_empty = timer_queue_.empty();
-	const auto s_duration = std::chrono::duration_cast<standard_duration_t>(duration);
-	timer_queue_.emplace(this->active_scene().get_event(marker, name), s_duration);
-	if (!was_empty) timer_wait_awakened_ = true;
-	timer_cv_.notify_one();
+auto Window::timer_dispatch_repeating_event(const marker_t marker, const std::string& name, duration_t<Period> interval) -> timer_handle_t {
+	const auto s_interval = std::chrono::duration_cast<standard_duration_t>(interval);
+	return this->timer_schedule(
+	  clock_.now() + s_interval, [event = this->active_scene().get_event(marker, name)] { event(event_data_t{}); }, s_interval);
+}
+
+/// \brief Schedules a callback on the timer wheel
+/// \details The callback runs on the window thread. Safe to call from any thread and lock-free: the timer is
+/// pushed onto a concurrent submission queue that the timer owner, the timer thread or the inline frame
+/// loop, merges into the timer wheel. The owner is only woken, under the timer mutex, when it sleeps
+/// past the new deadline
+/// \param deadline The time at which the callback is executed first
+/// \param fn The callback
+/// \param interval The duration between executions of a repeating callback, zero for a one-shot callback
+/// \returns The handle used to cancel the callback
+auto Window::timer_schedule(const time_point_t deadline, timer_event_fn_t&& fn, const standard_duration_t interval) -> timer_handle_t {
+	auto handle = timer_handle_t::create(std::move(fn));
+	this->timer_submit(timer_event_t(handle, deadline, interval));
+	return handle;
+}
+
+/// \brief Submits a timer to the timer owner
+/// \details Lock-free, see \sa Window::timer_schedule(). Timers without a \sa cui::TimerHandle cannot be
+/// cancelled or repeat, but do not allocate any shared state
+/// \param timer The timer to submit
+void Window::timer_submit(timer_event_t&& timer) {
+	const auto deadline = timer.deadline();
+	submitted_timers_.enqueue(std::move(timer));
+	submitted_count_.fetch_add(1);
+	if (deadline.time_since_epoch().count() < timer_wake_at_.load()) {
+		std::unique_lock lock(timer_signal_->mutex);
+		timer_signal_->awakened = true;
+		timer_signal_->cv.notify_one();
+	}
 }
 
-/// \brief Execute the next timer event in waiting queue
-/// \details Starts executing the event whose wait time is up
-void Window::timer_execute_next_in_line() {
-	std::unique_lock lock(timer_mutex);
-	dispatched_timer_events.enqueue(timer_queue_.top());
-	timer_queue_.pop();
+/// \brief Cancels a pending timer event
+/// \details Marks the handle as cancelled so the callback is skipped. The timer is also removed from the
+/// timer wheel right away if the timer mutex is free, otherwise it is dropped once it becomes due
+/// \param handle The handle returned when dispatching the timer event
+/// \returns A boolean indicating whether this call cancelled the timer
+bool Window::timer_cancel(const timer_handle_t& handle) {
+	if (!handle.cancel()) return false;
+
+	std::unique_lock lock(timer_signal_->mutex, std::try_to_lock);
+	if (lock.owns_lock()) timers_.cancel(handle.id());
+	return true;
 }
 
-/// \brief Waits the thread until the queue has elements or the window has stopped running
-/// \details Locks the timer mutex and performs an indefinite wait on enqueued timer events
+/// \brief Wraps an event so it only runs once no call happened for a delay
+/// \details Every call pushes the pending execution back and replaces its event data with a snapshot of the
+/// latest one, which is restored when the timer fires, see \sa Window::restore_event(). The execution is
+/// dropped if its caller is gone by then or the wrapper was destroyed. Must be dispatched from the window
+/// thread, eg. by registering the wrapper as an event
+/// \param event The event to debounce
+/// \param delay The quiet period after the last call
+/// \returns The debounced event
+auto Window::debounce(event_t&& event, const standard_duration_t delay) -> event_t {
+	struct State
+	{
+		event_t func;
+		async_event_data_t latest;
+		timer_handle_t pending;
+	};
+	auto state = std::make_shared<State>();
+	state->func = std::move(event);
+
+	return [this, state, delay](event_data_t event_data) {
+		state->latest = async_event_data_t(event_data, this->active_scene().graph().generation());
+		this->timer_cancel(state->pending);
+		// The pending handle owns the callback, so the callback only refers to the state weakly
+		state->pending = this->timer_schedule(clock_.now() + delay, [this, weak_state = std::weak_ptr<State>(state)] {
+			const auto locked = weak_state.lock();
+			if (!locked) return;
+			if (auto restored = this->restore_event(locked->latest)) locked->func(*restored);
+		});
+	};
+}
+
+/// \brief Wraps an event so it runs at most once per interval
+/// \details The first call of an interval runs immediately. Further calls within the interval collapse into
+/// a single trailing execution with a snapshot of the latest event data at the end of the interval, dropped if
+/// its caller is gone by then. Must be dispatched from the window thread, eg. by registering the wrapper as
+/// an event
+/// \param event The event to throttle
+/// \param interval The minimal duration between executions
+/// \returns The throttled event
+auto Window::throttle(event_t&& event, const standard_duration_t interval) -> event_t {
+	struct State
+	{
+		event_t func;
+		async_event_data_t latest;
+		time_point_t last_run;
+		bool trailing_pending = false;
+	};
+	auto state = std::make_shared<State>();
+	state->func = std::move(event);
+
+	return [this, state, interval](event_data_t event_data) {
+		const auto now = clock_.now();
+		if (!state->trailing_pending && now - state->last_run >= interval) {
+			state->last_run = now;
+			state->func(event_data);
+			return;
+		}
+
+		state->latest = async_event_data_t(event_data, this->active_scene().graph().generation());
+		if (state->trailing_pending) return;
+		state->trailing_pending = true;
+		this->timer_schedule(state->last_run + interval, [this, state] {
+			state->trailing_pending = false;
+			state->last_run = this->clock_.now();
+			if (auto restored = this->restore_event(state->latest)) state->func(*restored);
+		});
+	};
+}
+
+/// \brief Advances the timer wheel and hands every due callback to a sink
+/// \details Must be called with the timer mutex held. Cancelled timers are dropped, repeating timers are
+/// put back on the wheel at their next deadline and a copy holding only their handle is passed to the sink
+/// \param now The time to advance to
+/// \param sink A callable receiving each due \sa timer_event_t as an rvalue, marked as dispatched at now
+template <typename Sink>
+void Window::timer_advance(const time_point_t now, Sink&& sink) {
+	timers_.advance(now, [this, now, &sink](timer_event_t&& timer) {
+		if (timer.cancelled()) return;
+		timer.mark_dispatched(now);
+		if (!timer.repeating()) {
+			sink(std::move(timer));
+			return;
+		}
+
+		sink(timer_event_t(timer));
+		timer.advance_deadline(now);
+		const auto handle = timer.handle();
+		handle.id() = timers_.schedule(std::move(timer));
+	});
+}
+
+/// \brief Moves the submitted timers onto the timer wheel
+/// \details Must be called with the timer mutex held by the timer owner. Timers cancelled before they
+/// were merged are dropped, only timers with a \sa cui::TimerHandle get their wheel id recorded
+void Window::merge_submitted_timers() {
+	while (const auto count = submitted_timers_.try_dequeue_bulk(submitted_batch_.begin(), submitted_batch_.size())) {
+		merged_count_ += count;
+		for (std::size_t i = 0; i < count; ++i) {
+			auto& timer = submitted_batch_[i];
+			if (!timer.cancelled()) {
+				const auto handle = timer.handle();
+				const auto id = timers_.schedule(std::move(timer));
+				if (handle.valid()) handle.id() = id;
+			}
+			timer = timer_event_t{};
+		}
+	}
+}
+
+/// \brief Publishes the time the timer owner is about to sleep until
+/// \details Must be called with the timer mutex held. Producers that submit an earlier deadline afterwards
+/// wake the owner. The submission counter is checked after publishing, so a submission racing with
+/// the publish is either seen here or sees the published time
+/// \param until The time to sleep until or nothing to sleep indefinitely
+/// \returns A boolean indicating whether the owner may sleep, false if unmerged submissions are pending
+bool Window::publish_timer_wait(const std::optional<time_point_t> until) {
+	timer_wake_at_.store(until ? until->time_since_epoch().count() : std::numeric_limits<standard_duration_t::rep>::max());
+	if (submitted_count_.load() == merged_count_) return true;
+
+	timer_wake_at_.store(std::numeric_limits<standard_duration_t::rep>::min());
+	return false;
+}
+
+/// \brief Checks whether UI mutations or commands were posted and not yet applied
+/// \details The fence pairs with the one in \sa Window::wake_frame_loop(), so a post racing with a loop going to
+/// sleep is either seen here or sees the published wake time
+bool Window::has_posted_work() const noexcept {
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	return ui_tasks.size_approx() > 0 || ui_commands_.size_approx() > 0;
+}
+
+/// \brief Wakes the frame loop if it sleeps, after a UI mutation or command was posted
+/// \details The timer thread of a window without inline timers is left alone, its frame loop does not sleep
+void Window::wake_frame_loop() {
+	if (!inline_timers_ && !pipelined_) return;
+
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (timer_wake_at_.load() == std::numeric_limits<standard_duration_t::rep>::min()) return;
+
+	std::unique_lock lock(timer_signal_->mutex);
+	timer_signal_->awakened = true;
+	timer_signal_->cv.notify_one();
+}
+
+/// \brief Moves every due timer event into the dispatched timer events queue
+/// \details Advances the timer wheel to the current time, called by the timer thread
+void Window::timer_dispatch_due() {
+	CUI_PROFILE_SCOPE("timer_dispatch_due");
+	std::unique_lock lock(timer_signal_->mutex);
+	this->merge_submitted_timers();
+	this->timer_advance(clock_.now(), [this](timer_event_t&& timer) { dispatched_timer_events.enqueue(std::move(timer)); });
+}
+
+/// \brief Runs every due timer event on the calling thread
+/// \details Advances the timer wheel straight into the batch of \sa Window::run_dispatched_timer_events,
+/// then runs it within the timer budget. The callbacks run after the timer mutex is released, so they
+/// may schedule or cancel timers themselves
+/// \returns The amount of timer events that ran
+auto Window::run_due_timers() -> std::size_t {
+	CUI_PROFILE_SCOPE("run_due_timers");
+	{
+		std::unique_lock lock(timer_signal_->mutex);
+		this->merge_submitted_timers();
+		if (timer_batch_begin_ == timer_batch_end_) timer_batch_begin_ = timer_batch_end_ = 0;
+		this->timer_advance(clock_.now(), [this](timer_event_t&& timer) {
+			if (timer_batch_end_ == timer_batch_.size()) {
+				timer_batch_.push_back(std::move(timer));
+			} else {
+				timer_batch_[timer_batch_end_] = std::move(timer);
+			}
+			++timer_batch_end_;
+		});
+	}
+	return this->run_dispatched_timer_events();
+}
+
+/// \brief Sleeps until the next frame, the earliest timer deadline, a newly scheduled timer or a posted UI mutation
+/// \details The remaining time is measured on \sa Window::clock() and slept in real time, so a virtual clock
+/// that is not advanced behaves like a real one while \sa Window::advance_clock() wakes the loop early
+/// \param next_frame The time the next frame is due
+void Window::frame_wait(const time_point_t next_frame) {
+	std::unique_lock lock(timer_signal_->mutex);
+	this->merge_submitted_timers();
+	const auto next_deadline = timers_.next_deadline();
+	const auto until = next_deadline ? std::min(next_frame, *next_deadline) : next_frame;
+	if (this->publish_timer_wait(until) && !this->has_posted_work()) timer_signal_->cv.wait_for(lock, until - clock_.now(), [this] { return timer_signal_->awakened; });
+	timer_wake_at_.store(std::numeric_limits<standard_duration_t::rep>::min());
+	timer_signal_->awakened = false;
+}
+
+/// \brief Waits until the earliest timer deadline, an earlier submitted timer event or the window stopping
+/// \details Merges the submitted timers first and does not wait while more are pending. Waits indefinitely
+/// while no timer event is pending. Deadlines are measured on \sa Window::clock()
 /// \returns A boolean indicating whether the window has stopped running
-bool Window::timer_wait_until_push() noexcept {
-	std::unique_lock lock(timer_mutex);
-	timer_cv_.wait(lock, [this] { return !this->is_running() || !timer_queue_.empty(); });
+bool Window::timer_wait() {
+	std::unique_lock lock(timer_signal_->mutex);
+	this->merge_submitted_timers();
+	const auto interrupted = [this] { return timer_signal_->awakened || !this->is_running(); };
+	const auto next = timers_.next_deadline();
+	if (this->publish_timer_wait(next)) {
+		if (next) {
+			timer_signal_->cv.wait_for(lock, *next - clock_.now(), interrupted);
+		} else {
+			timer_signal_->cv.wait(lock, interrupted);
+		}
+	}
+	timer_wake_at_.store(std::numeric_limits<standard_duration_t::rep>::min());
+	timer_signal_->awakened = false;
 	return !this->is_running();
 }
 
-/// \brief Waits for the wait duration of the shortest timer event
-/// \details The wait may be interrupted from the outside
-/// \param previous The previous duration waited on
-/// \returns A boolean indicating whether or not the wait has been interrupted
-bool Window::timer_wait_for(standard_duration_t& previous) {
-	std::unique_lock lock(timer_mutex);
-	time_point_t before = steady_clock_t::now();
-	timer_cv_.wait_for(lock, timer_queue_.top().duration() - previous);
-	previous = steady_clock_t::now() - before;
-	if (timer_wait_awakened_) {
-		timer_wait_awakened_ = false;
-		return true;
+/// \brief Advances a virtual clock and wakes the timer owner
+/// \details Does nothing while \sa Window::clock() runs in real time. Safe to call from any thread
+/// \param duration The duration to advance by
+void Window::advance_clock(const standard_duration_t duration) {
+	clock_.advance(duration);
+
+	std::unique_lock lock(timer_signal_->mutex);
+	timer_signal_->awakened = true;
+	timer_signal_->cv.notify_one();
+}
+
+/// \brief Runs frames as fast as possible on a virtual clock
+/// \details Switches \sa Window::clock() to virtual time and runs the UI tasks, timers, animations and cache
+/// updates of every frame on the calling thread without rendering. Between frames the clock jumps to each
+/// timer deadline, so timers run at their exact virtual time. Meant for benchmarks and tests, the window must
+/// not be running its own frame loop
+/// \param duration The amount of virtual time to simulate
+/// \param frame_interval The virtual duration of a frame
+/// \returns The costs of the simulation
+auto Window::simulate(const standard_duration_t duration, const standard_duration_t frame_interval) -> SimulationStats {
+	if (frame_interval <= standard_duration_t::zero()) throw std::logic_error("The frame interval has to be positive");
+	if (!clock_.is_virtual()) clock_.use_virtual();
+	if (cache_.empty()) this->init_cache();
+
+	SimulationStats stats;
+	const auto wall_start = steady_clock_t::now();
+	const auto cpu_start = std::clock();
+	const auto start = clock_.now();
+	const auto end = start + duration;
+	auto next_frame = start;
+
+	while (next_frame <= end) {
+		while (true) {
+			std::optional<time_point_t> next_deadline;
+			{
+				std::unique_lock lock(timer_signal_->mutex);
+				this->merge_submitted_timers();
+				next_deadline = timers_.next_deadline();
+			}
+			if (!next_deadline || *next_deadline >= next_frame || *next_deadline <= clock_.now()) break;
+
+			clock_.advance_to(*next_deadline);
+			stats.timer_count += this->run_due_timers();
+		}
+
+		clock_.advance_to(next_frame);
+		const auto frame_start = steady_clock_t::now();
+		this->apply_ui_tasks();
+		this->apply_ui_commands();
+		stats.timer_count += this->run_due_timers();
+		this->run_animations();
+		this->run_virtual_lists();
+		if (update_cache_flag_.exchange(false)) this->update_cache();
+
+		const auto frame_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(steady_clock_t::now() - frame_start);
+		stats.max_frame_duration = std::max(stats.max_frame_duration, frame_duration);
+		++stats.frame_count;
+		next_frame += frame_interval;
 	}
-	return false;
+
+	stats.simulated_duration = clock_.now() - start;
+	stats.wall_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(steady_clock_t::now() - wall_start);
+	stats.cpu_duration = std::chrono::nanoseconds(static_cast<i64>(static_cast<double>(std::clock() - cpu_start) * 1e9 / CLOCKS_PER_SEC));
+	return stats;
+}
+
+/// \brief Runs the due timer events of this frame
+/// \details Dequeues the dispatched timer events in bulk into a reusable batch and runs them until the
+/// queue is empty or the timer budget is spent. Callbacks left in the batch run first on the next frame,
+/// so at least one callback runs per frame and the order is preserved. The latency of every callback is
+/// recorded into \sa Window::timer_latency() using the clock reading of the budget check. The budget is
+/// always measured in real time, latencies in the time of \sa Window::clock()
+/// \returns The amount of timer events that ran
+auto Window::run_dispatched_timer_events() -> std::size_t {
+	CUI_PROFILE_SCOPE("run_timers");
+	auto now = steady_clock_t::now();
+	const auto budget_end = now + timer_budget_;
+	const auto is_virtual = clock_.is_virtual();
+	std::size_t ran = 0;
+
+	while (true) {
+		if (timer_batch_begin_ == timer_batch_end_) {
+			timer_batch_begin_ = 0;
+			timer_batch_end_ = dispatched_timer_events.try_dequeue_bulk(timer_batch_.begin(), timer_batch_.size());
+			if (timer_batch_end_ == 0) return ran;
+		}
+
+		while (timer_batch_begin_ < timer_batch_end_) {
+			const auto timer = std::move(timer_batch_[timer_batch_begin_++]);
+			const auto run_at = is_virtual ? clock_.now() : now;
+			timer_latency_.schedule_to_run.record(run_at - timer.deadline());
+			timer_latency_.dequeue_to_run.record(run_at - timer.dispatched_at());
+			timer();
+			++ran;
+			now = steady_clock_t::now();
+			if (now >= budget_end) return ran;
+		}
+	}
+}
+
+/// \brief Starts recording every event passed to \sa Window::process_event
+/// \details Replaces a recording that is already in progress
+/// \param path The path of the recording
+void Window::start_recording(const std::string& path) {
+	recorder_.open(path);
+}
+
+/// \brief Stops the recording in progress
+void Window::stop_recording() {
+	recorder_.close();
+}
+
+/// \brief Replays a recorded event stream through \sa Window::process_event
+/// \details Every event is followed by a frame step that applies posted UI mutations and commands, runs due
+/// timers, animations and virtual lists and updates the cache if scheduled, so the per event timings cover
+/// the handlers and the frame work they cause, drawing excluded. With \sa EventReplayer::Speed::Maximum the
+/// clock of the window is virtual during the replay and jumps to each recorded timestamp before the event
+/// is processed, so timers and animations follow the recorded timeline. At the recorded pace the clock is
+/// left as it is. Must be called on the window thread
+/// \param replayer The replayer holding the loaded recording
+/// \param speed The pace of the replay
+/// \returns The timings of the replay
+auto Window::replay_events(EventReplayer& replayer, const EventReplayer::Speed speed) -> EventReplayer::Stats {
+	const auto follow_recording = speed == EventReplayer::Speed::Maximum;
+	const auto switch_clock = follow_recording && !clock_.is_virtual();
+	if (switch_clock) clock_.use_virtual();
+	const auto start = clock_.now();
+
+	const auto stats = replayer.replay(
+		[this, &replayer, start, follow_recording](const sf::Event& event) {
+			if (follow_recording) clock_.advance_to(start + std::chrono::duration_cast<standard_duration_t>(replayer.virtual_time()));
+			this->process_event(event);
+		},
+		speed,
+		[this](std::chrono::nanoseconds) {
+			this->apply_ui_tasks();
+			this->apply_ui_commands();
+			this->run_due_timers();
+			this->run_animations();
+			this->run_virtual_lists();
+			if (update_cache_flag_.exchange(false)) this->update_cache();
+		});
+
+	if (switch_clock) clock_.use_real();
+	return stats;
+}
+
+/// \brief Animates a numeric attribute of a node
+/// \details Must be called on the window thread. If no node is found, an exception is thrown
+/// \param node_name The name of the node to animate
+/// \param attribute One of x, y, width or height
+/// \param to The value to animate to
+/// \param duration The duration of the animation
+/// \param easing The easing curve, eg. \sa easing::quad_out
+/// \param on_finish Optional callback invoked on the window thread once the value is reached
+/// \returns The id used to cancel the animation
+auto Window::animate(const std::string& node_name,
+					 const VisualAttribute attribute,
+					 const float to,
+					 const standard_duration_t duration,
+					 const easing_t easing,
+					 ui_task_t&& on_finish) -> animation_id_t {
+	if (attribute != VisualAttribute::X && attribute != VisualAttribute::Y && attribute != VisualAttribute::Width && attribute != VisualAttribute::Height) {
+		throw std::logic_error("Only x, y, width and height can be animated to a number");
+	}
+
+	auto& graph = this->active_scene().graph();
+	const auto index = graph.find_index(node_name);
+	if (!index || *index == scene_graph_t::root_index) throw std::logic_error("No node found by that name");
+
+	return animator_.animate(graph, cache_, *index, attribute, animator_t::numeric(to), duration, easing, std::move(on_finish), clock_.now());
+}
+
+/// \brief Animates a color attribute of a node
+/// \details Must be called on the window thread. If no node is found, an exception is thrown
+/// \param node_name The name of the node to animate
+/// \param attribute One of background or text_color
+/// \param to The color to animate to
+/// \param duration The duration of the animation
+/// \param easing The easing curve, eg. \sa easing::quad_out
+/// \param on_finish Optional callback invoked on the window thread once the color is reached
+/// \returns The id used to cancel the animation
+auto Window::animate(const std::string& node_name,
+					 const VisualAttribute attribute,
+					 const Color& to,
+					 const standard_duration_t duration,
+					 const easing_t easing,
+					 ui_task_t&& on_finish) -> animation_id_t {
+	if (attribute != VisualAttribute::Background && attribute != VisualAttribute::TextColor) {
+		throw std::logic_error("Numeric attributes must be animated to a number");
+	}
+
+	auto& graph = this->active_scene().graph();
+	const auto index = graph.find_index(node_name);
+	if (!index || *index == scene_graph_t::root_index) throw std::logic_error("No node found by that name");
+
+	return animator_.animate(graph, cache_, *index, attribute, animator_t::color(to), duration, easing, std::move(on_finish), clock_.now());
+}
+
+/// \brief Stops an animation, leaving the attribute at its current value
+/// \param id The id returned by \sa Window::animate()
+/// \returns A boolean indicating whether the animation was still running
+bool Window::cancel_animation(const animation_id_t id) {
+	return animator_.cancel(id);
+}
+
+/// \brief Advances the running animations to the current frame
+/// \details Only the animated nodes are refreshed in the \sa RenderCache. Moves and color fades of leaf nodes
+/// are written directly into their \sa VisualElement, size changes update the subtree of the node. When a
+/// full cache update is already scheduled for this frame the per-node refresh is skipped
+void Window::run_animations() {
+	if (animator_.empty()) return;
+	CUI_PROFILE_SCOPE("run_animations");
+
+	auto& graph = this->active_scene().graph();
+	animator_.advance(graph, clock_.now());
+	if (!update_cache_flag_) {
+		for (const auto& [index, attributes] : animator_.dirty_nodes()) {
+			cache_.update_attributes(graph, index, attributes);
+		}
+		if (!animator_.dirty_nodes().empty()) this->reposition_virtual_rows();
+	}
+	frame_dirty_ = true;
+	animator_.run_finished();
+}
+
+#ifdef CUI_HAS_COROUTINES
+/// \brief Suspends a \sa cui::Task for a duration
+/// \details The coroutine resumes on the window thread through the timer wheel, eg. co_await window.delay(2s)
+/// \param duration The duration to wait, the coroutine does not suspend if it is not positive
+/// \returns The awaitable
+auto Window::delay(const standard_duration_t duration) -> detail::DelayAwaiter<Window> {
+	return detail::DelayAwaiter<Window>(*this, duration);
+}
+
+/// \brief Suspends a \sa cui::Task until the start of the next frame
+/// \returns The awaitable
+auto Window::next_frame() -> detail::NextFrameAwaiter<Window> {
+	return detail::NextFrameAwaiter<Window>(*this);
+}
+
+/// \brief Runs a job on the worker pool from a \sa cui::Task
+/// \details The coroutine resumes on the window thread with the result of the job, eg.
+/// auto data = co_await window.run_on_worker([] { return load(); })
+/// \tparam Job A callable taking no arguments
+/// \param job The job to run
+/// \returns The awaitable
+template <typename Job>
+auto Window::run_on_worker(Job&& job) -> detail::WorkerAwaiter<Window, std::decay_t<Job>> {
+	return detail::WorkerAwaiter<Window, std::decay_t<Job>>(*this, std::decay_t<Job>(std::forward<Job>(job)));
+}
+#endif
+
+/// \brief Inserts nodes into the active scene at runtime
+/// \details Must be called on the window thread, eg. inside \sa Window::post_to_ui(). The resources of the new
+/// nodes are cached and only their elements are laid out, the rest of the \sa RenderCache is kept. Running
+/// animations follow the remapped indices. If no parent is found, an exception is thrown
+/// \param parent_name The name of the parent node, the name of the root inserts top level nodes
+/// \param subtree The nodes to insert, see \sa SceneGraph::insert_subtree()
+/// \param child_position The position among the children of the parent, appends by default
+/// \returns The remap describing the inserted range
+auto Window::insert_subtree(const std::string& parent_name, tree_t&& subtree, const std::size_t child_position) -> remap_t {
+	const auto parent = this->active_scene().graph().find_index(parent_name);
+	if (!parent) throw std::logic_error("No node found by that name");
+	return this->insert_subtree_at(*parent, std::move(subtree), child_position);
+}
+
+/// \brief Removes a node and its descendants from the active scene at runtime
+/// \details Must be called on the window thread, eg. inside \sa Window::post_to_ui(). Only the elements of
+/// the removed nodes are dropped from the \sa RenderCache. Animations of removed nodes are cancelled. If no
+/// node is found, an exception is thrown
+/// \param node_name The name of the node to remove
+/// \returns The remap describing the removed indices
+auto Window::remove_subtree(const std::string& node_name) -> remap_t {
+	const auto index = this->active_scene().graph().find_index(node_name);
+	if (!index) throw std::logic_error("No node found by that name");
+	return this->remove_subtree_at(*index);
+}
+
+/// \brief Inserts instances of a prototype into the active scene at runtime
+/// \details See \sa Window::insert_subtree(). The instances share the schematics of the prototype until they
+/// are changed, see \sa cui::Prototype
+/// \param parent_name The name of the parent node, the name of the root inserts top level nodes
+/// \param prototype The prototype to instantiate
+/// \param count The amount of instances
+/// \param name The name prefix of the instances, instance i is named <name>#<i>
+/// \param child_position The position of the first instance among the children of the parent, appends by default
+/// \returns The remap describing the inserted range
+auto Window::instantiate(const std::string& parent_name,
+						 const prototype_t& prototype,
+						 const std::size_t count,
+						 const std::string& name,
+						 const std::size_t child_position) -> remap_t {
+	return this->insert_subtree(parent_name, prototype.instantiate(count, name), child_position);
+}
+
+/// \brief Applies an edit script to the active scene at runtime
+/// \details Must be called on the window thread, eg. inside \sa Window::post_to_ui(). Inserts and removals go
+/// through \sa Window::insert_subtree() and \sa Window::remove_subtree(), a move removes the subtree and
+/// inserts it at its new place. Updated nodes take the text and share the schematics of their target node and
+/// only their elements are refreshed. Moved and updated nodes fall back to their default schematic. If the
+/// diff was not computed against this graph, an exception is thrown.
+///
+/// Structural edits are logged instead of being applied to the location of every id, an id is only brought
+/// through the log when an edit refers to it and a move only walks the moved subtree. Each insert, move and
+/// removal still shifts the graph, its name and style indices and the \sa RenderCache, O(n) for n nodes, so
+/// k structural edits cost O(k * n) while updates cost the size of the updated subtree
+/// \param diff The edit script, see \sa cui::SceneDiff
+void Window::apply_diff(const scene_diff_t& diff) {
+	CUI_PROFILE_SCOPE("apply_diff");
+	auto& graph = this->active_scene().graph();
+	if (graph.length() != diff.current_length()) throw std::logic_error("The diff was computed against a different graph");
+
+	constexpr auto npos = scene_diff_t::npos;
+	// A logged structural edit, a move also records the new index of every moved node by its old index
+	struct Step
+	{
+		remap_t removal;
+		remap_t insertion;
+		tsl::hopscotch_map<std::size_t, std::size_t> moved;
+	};
+	std::vector<Step> steps;
+	// The index of every id and the amount of logged steps it was brought through
+	std::vector<std::pair<std::size_t, std::size_t>> location(diff.id_count(), {npos, 0});
+	for (std::size_t i = 0; i < diff.current_length(); ++i) location[i].first = i;
+
+	const auto resolve = [&steps, &location](const std::size_t id) -> std::size_t {
+		if (id == npos) return npos;
+
+		auto& [index, applied] = location[id];
+		for (; applied < steps.size() && index != npos; ++applied) {
+			const auto& step = steps[applied];
+			const auto moved_it = step.moved.find(index);
+			index = moved_it != step.moved.end() ? moved_it->second : step.insertion.map(step.removal.map(index));
+		}
+		applied = steps.size();
+		return index;
+	};
+	const auto place = [&graph](const std::size_t parent, const std::size_t after) -> std::pair<std::size_t, std::size_t> {
+		if (after == npos) return {parent, 0};
+
+		if (parent != tree_t::no_parent) {
+			const auto& siblings = graph[parent].children();
+			return {parent, static_cast<std::size_t>(std::find(siblings.begin(), siblings.end(), after) - siblings.begin()) + 1};
+		}
+
+		std::size_t position = 0;
+		for (std::size_t i = 0; i <= after; ++i) {
+			if (graph[i].parent() == tree_t::no_parent) ++position;
+		}
+		return {parent, position};
+	};
+
+	for (const auto& edit : diff.edits()) {
+		switch (edit.kind) {
+			case scene_diff_t::Kind::Insert: {
+				const auto [parent, child_position] = place(resolve(edit.parent), resolve(edit.after));
+				const auto remap = this->insert_subtree_at(parent, tree_t(edit.subtree), child_position);
+				steps.push_back({remap_t(), remap, {}});
+				for (std::size_t k = 0; k < edit.ids.size(); ++k) location[edit.ids[k]] = {remap.position() + k, steps.size()};
+				break;
+			}
+			case scene_diff_t::Kind::Move: {
+				const auto index = resolve(edit.node);
+				const auto parent = resolve(edit.parent);
+				const auto after = resolve(edit.after);
+
+				// The prototype holds the subtree in pre-order, which is the order the moved indices are collected in
+				const auto moved = prototype_t::from_graph(graph, index);
+				std::vector<std::size_t> moved_indices;
+				moved_indices.reserve(moved.length());
+				std::vector<std::size_t> order{index};
+				while (!order.empty()) {
+					const auto current = order.back();
+					order.pop_back();
+					moved_indices.push_back(current);
+					const auto& children = graph[current].children();
+					order.insert(order.end(), children.rbegin(), children.rend());
+				}
+
+				Step step;
+				step.removal = this->remove_subtree_at(index);
+				const auto [new_parent, child_position] = place(step.removal.map(parent), step.removal.map(after));
+				step.insertion = this->insert_subtree_at(new_parent, tree_t(moved.tree()), child_position);
+				step.moved.reserve(moved_indices.size());
+				for (std::size_t k = 0; k < moved_indices.size(); ++k) {
+					step.moved.emplace(moved_indices[k], step.insertion.position() + k);
+				}
+				steps.push_back(std::move(step));
+				break;
+			}
+			case scene_diff_t::Kind::Update: {
+				const auto index = resolve(edit.node);
+				auto& node = graph[index].data();
+				if (edit.text) node.text() = edit.source->text();
+				if (edit.schematics) {
+					node.share_schematics(*edit.source);
+					cache_.cache_resource(node);
+					cache_.update_subtree(graph, index);
+				} else {
+					cache_.update_attributes(graph, index, attribute_bit(VisualAttribute::Text));
+				}
+				this->reposition_virtual_rows();
+				frame_dirty_ = true;
+				break;
+			}
+			case scene_diff_t::Kind::Remove: {
+				const auto index = resolve(edit.node);
+				if (index != npos) steps.push_back({this->remove_subtree_at(index), remap_t(), {}});
+				break;
+			}
+		}
+	}
+}
+
+/// \brief Turns the active scene into a target tree with as few edits as possible
+/// \details Computes a \sa cui::SceneDiff and applies it, eg. window.patch(SceneGraph(new_scene, styles)) to
+/// bring a new \sa ct::Scene to a live window without rebuilding the \sa RenderCache. The resources of the
+/// target are cached before diffing, so patching with the tree the scene was built from yields no edits. Must
+/// be called on the window thread
+/// \param target The tree to turn the active scene into
+/// \returns The applied edit script
+auto Window::patch(const tree_t& target) -> scene_diff_t {
+	// Live nodes hold resource path heads, so the target gets its resources cached first and unchanged
+	// backgrounds and fonts compare equal
+	auto normalized = target;
+	for (auto& node : normalized) cache_.cache_resource(node.data());
+
+	scene_diff_t diff(this->active_scene().graph(), normalized);
+	this->apply_diff(diff);
+	return diff;
+}
+
+/// \brief Inserts nodes under a parent given by index, see \sa Window::insert_subtree()
+auto Window::insert_subtree_at(const std::size_t parent, tree_t&& subtree, const std::size_t child_position) -> remap_t {
+	auto& graph = this->active_scene().graph();
+	const auto remap = graph.insert_subtree(parent, std::move(subtree), child_position);
+	if (remap.empty()) return remap;
+
+	for (auto i = remap.position(); i < remap.position() + remap.inserted(); ++i) cache_.cache_resource(graph[i].data());
+	cache_.apply_remap(graph, remap);
+	animator_.apply_remap(remap);
+	frame_dirty_ = true;
+	return remap;
+}
+
+/// \brief Removes a node given by index and its descendants, see \sa Window::remove_subtree()
+auto Window::remove_subtree_at(const std::size_t index) -> remap_t {
+	auto& graph = this->active_scene().graph();
+	const auto remap = graph.remove_subtree(index);
+	cache_.apply_remap(graph, remap);
+	animator_.apply_remap(remap);
+	frame_dirty_ = true;
+	return remap;
+}
+
+/// \brief Turns a node of the active scene into a virtualized list
+/// \details Must be called on the window thread after the cache was filled. The node keeps its place and size
+/// in the scene and acts as the viewport. Its first child subtree is taken out of the scene as the row
+/// template. Rows are copies of the template named <list_name>#<slot>; only those intersecting the viewport
+/// plus the overscan exist and each is bound to its item through the bind callback when it shows a new one.
+/// Rows are positioned by their y attribute, so the template should not rely on a y rule. Throws if the node
+/// does not exist, has no children or already is a list
+/// \param list_name The name of the node acting as the viewport
+/// \param item_count The amount of items in the list
+/// \param row_height The height of a row in pixels
+/// \param bind Fills a row with the data of an item, receives the item, the graph and the index of the row
+/// node. Descendants of the row are reached through the children of that node, their names repeat per row
+/// \param overscan The amount of rows kept materialized above and below the viewport
+/// \returns The list, to scroll it or change its item count
+auto Window::virtualize(const std::string& list_name,
+						const std::size_t item_count,
+						const float row_height,
+						virtual_bind_t&& bind,
+						const std::size_t overscan) -> virtual_list_t& {
+	auto& graph = this->active_scene().graph();
+	const auto container = graph.find_index(list_name);
+	if (!container) throw std::logic_error("No node found by that name");
+	if (graph[*container].children().empty()) throw std::logic_error("The list node has no row template");
+	for (const auto& list : virtual_lists_) {
+		if (list->name() == list_name) throw std::logic_error("The node already is a virtual list");
+	}
+
+	const auto template_index = graph[*container].children().front();
+	auto row_template = prototype_t::from_graph(graph, template_index);
+	this->remove_subtree_at(template_index);
+	virtual_lists_.push_back(
+		std::make_unique<virtual_list_t>(list_name, std::move(row_template), item_count, row_height, overscan, std::move(bind)));
+	auto& list = *virtual_lists_.back();
+	this->sync_virtual_list(list);
+	return list;
+}
+
+/// \brief Gets a list created by \sa Window::virtualize(), if none is found an exception is thrown
+/// \param list_name The name of the node acting as the viewport
+auto Window::virtual_list(const std::string& list_name) -> virtual_list_t& {
+	for (auto& list : virtual_lists_) {
+		if (list->name() == list_name) return *list;
+	}
+	throw std::logic_error("No virtual list found by that name");
+}
+
+/// \brief Brings the rows of every scrolled, resized or invalidated list up to date
+void Window::run_virtual_lists() {
+	for (auto& list : virtual_lists_) {
+		if (list->dirty()) this->sync_virtual_list(*list);
+	}
+}
+
+/// \brief Schedules every list to place its rows again
+/// \details Rows are placed by translating their elements in the \sa RenderCache, their schematics keep the
+/// position of the row template so rows keep sharing them. Refreshing a row node from its schematics moves
+/// it back, which the next \sa Window::run_virtual_lists() corrects without rebinding
+void Window::reposition_virtual_rows() {
+	for (auto& list : virtual_lists_) list->dirty() = true;
+}
+
+/// \brief Materializes, recycles, binds and positions the rows of a list
+/// \details Adds or removes rows when the amount of rows the viewport needs changed, which rebinds all of
+/// them. Every materialized row is then moved to the position of its item by translating its subtree in the
+/// \sa RenderCache, the schematics of the row are left untouched. Rows outside the viewport, the overscan,
+/// are kept in the cache but hidden since elements are not clipped by their parents. Lists whose node was
+/// removed are skipped
+/// \param list The list to synchronize
+void Window::sync_virtual_list(virtual_list_t& list) {
+	CUI_PROFILE_SCOPE("sync_virtual_list");
+	list.dirty() = false;
+
+	auto& graph = this->active_scene().graph();
+	const auto container = graph.find_index(list.name());
+	if (!container) return;
+
+	const auto top = cache_[*container + 1].getPosition().y;
+	const auto height = cache_[*container + 1].getSize().y;
+	const auto span = list.span(height);
+
+	auto& rows = list.rows();
+	if (rows.size() != span.size()) {
+		while (rows.size() < span.size()) {
+			this->insert_subtree_at(*container, list.row_template().instantiate(list.row_name(rows.size())));
+			rows.push_back({list.row_name(rows.size())});
+		}
+		while (rows.size() > span.size()) {
+			if (const auto index = graph.find_index(rows.back().name)) this->remove_subtree_at(*index);
+			rows.pop_back();
+		}
+		list.invalidate();
+		list.dirty() = false;
+	}
+
+	std::vector<std::size_t> pending;
+	for (auto item = span.first; item < span.last; ++item) {
+		auto& row = rows[item % rows.size()];
+		const auto index = graph.find_index(row.name);
+		if (!index) continue;
+
+		if (row.item != item) {
+			list.bind()(item, graph, *index);
+			row.item = item;
+			cache_.update_subtree(graph, *index);
+		}
+
+		const auto y = top + static_cast<float>(item) * list.row_height() - list.scroll_offset();
+		const auto dy = y - cache_[*index + 1].getPosition().y;
+		const auto in_viewport = y + list.row_height() > top && y < top + height;
+		pending.assign(1, *index);
+		while (!pending.empty()) {
+			const auto current = pending.back();
+			pending.pop_back();
+
+			auto& ve = cache_[current + 1];
+			if (dy != 0) {
+				const auto [ve_x, ve_y] = ve.getPosition();
+				ve.setPosition(ve_x, ve_y + dy, cache_.front());
+				ve.text().move(0, dy);
+			}
+			const auto size = ve.getSize();
+			ve.visible() = in_viewport && !(size.x == 0 && size.y == 0);
+			pending.insert(pending.end(), graph[current].children().begin(), graph[current].children().end());
+		}
+	}
+	frame_dirty_ = true;
 }
 
 /// \brief Schedule to update the \sa RenderCache
-/// \details Sets the update cache flag to true
+/// \details Sets the update cache flag to true, safe to call from any thread
 void Window::schedule_to_update_cache() {
 	update_cache_flag_ = true;
 }
@@ -455,37 +1959,145 @@ void Window::schedule_to_update_cache() {
 /// \brief Updates the internal \sa RenderCache
 /// \details Locks the internal scene mutex with a \sa std::shared_lock
 void Window::update_cache() {
+	CUI_PROFILE_SCOPE("update_cache");
 	cache_.update_cache(this->active_scene().graph());
+	frame_dirty_ = true;
+
+	for (auto& list : virtual_lists_) this->sync_virtual_list(*list);
+}
+
+/// \brief Checks whether the frame loop has work for another frame before it may sleep
+/// \details True while the frame has to be rendered, animations run, virtual lists wait to be synchronized,
+/// timers are left over from an exhausted timer budget or UI mutations and commands were posted
+bool Window::has_pending_work() const noexcept {
+	if (this->needs_render() || !animator_.empty() || timer_batch_begin_ != timer_batch_end_) return true;
+	if (std::any_of(virtual_lists_.begin(), virtual_lists_.end(), [](const auto& list) { return list->dirty(); })) return true;
+	return ui_tasks.size_approx() > 0 || ui_commands_.size_approx() > 0;
 }
 
 /// \brief Renders the current scene
-/// \details Iterates through the cache and draws visible elements then displays them
+/// \details Updates the cache if scheduled, then draws it
 void Window::render() noexcept {
-	if (update_cache_flag_) {
+	CUI_PROFILE_SCOPE("render");
+	if (update_cache_flag_.exchange(false)) {
 		println("Updating the cache");
 		this->update_cache();
-		update_cache_flag_ = false;
 	}
+	this->draw(cache_);
+	frame_dirty_ = false;
+
+	if (frame_input_time_) {
+		this->record_input_latency(*frame_input_time_);
+		frame_input_time_.reset();
+	}
+}
+
+/// \brief Draws visible elements then displays them
+/// \param elements The render records to draw, either the cache or a \sa Window::FrameSnapshot
+void Window::draw(const std::vector<VisualElement>& elements) noexcept {
+	CUI_PROFILE_SCOPE("draw");
 	window_->clear();
-	for (const auto& ve : cache_) {
+	for (const auto& ve : elements) {
 		window_->setView(ve);
 		if (!ve.visible()) continue;
 		window_->draw(ve);
 		if (!ve.text().getString().isEmpty()) window_->draw(ve.text());
 	}
+
+	CUI_PROFILE_SCOPE("display");
 	window_->display();
 }
 
+/// \brief Hands the render records of this frame to the render thread
+/// \details Updates the cache if scheduled, then copies it into the back slot of the triple buffer. The copy
+/// reuses the allocations of the slot, the font list is only rebuilt when a font was added. Frames without
+/// visual changes or input are not published, the render thread keeps displaying the latest snapshot
+void Window::publish_frame() {
+	if (update_cache_flag_.exchange(false)) this->update_cache();
+	if (!frame_dirty_ && !frame_input_time_) return;
+
+	auto& snapshot = frames_.back();
+	snapshot.elements.assign(cache_.begin(), cache_.end());
+	if (snapshot.fonts.size() != cache_.fonts.size()) {
+		snapshot.fonts.clear();
+		for (auto font_it = cache_.fonts.begin(); font_it != cache_.fonts.end(); ++font_it) {
+			snapshot.fonts.push_back({font_it->second.get(), font_it->first, cache_.font_files[font_it->first]});
+		}
+	}
+	snapshot.input_time = frame_input_time_;
+	{
+		std::unique_lock lock(frames_mutex_);
+		frames_.publish();
+	}
+	frames_cv_.notify_one();
+
+	frame_input_time_.reset();
+	frame_dirty_ = false;
+}
+
+/// \brief Render thread loop of the pipelined mode
+/// \details Sleeps until the UI thread publishes a \sa Window::FrameSnapshot and draws it while the UI thread
+/// handles the input of the next frame, so nothing is drawn while the UI is idle. Texts are pointed at fonts
+/// loaded by this thread, keyed by their path head, glyphs are rasterized into a font by the thread using it
+/// only. Paced by the framerate limit of the window
+void Window::render_frames() {
+	tsl::hopscotch_map<std::string, std::unique_ptr<sf::Font>> fonts;
+	tsl::hopscotch_map<const sf::Font*, const sf::Font*> own_fonts;
+
+	window_->setActive(true);
+	while (true) {
+		{
+			std::unique_lock lock(frames_mutex_);
+			frames_cv_.wait(lock, [this] { return frames_.fresh() || render_stop_.load(std::memory_order_acquire); });
+		}
+		if (render_stop_.load(std::memory_order_acquire)) break;
+
+		frames_.consume();
+		auto& snapshot = frames_.front();
+		own_fonts.clear();
+		for (const auto& source : snapshot.fonts) {
+			auto font_it = fonts.find(source.name);
+			if (font_it == fonts.end()) {
+				auto font = std::make_unique<sf::Font>();
+				font->loadFromFile(source.file);
+				font_it = fonts.emplace(source.name, std::move(font)).first;
+			}
+			own_fonts[source.font] = font_it->second.get();
+		}
+		for (auto& ve : snapshot.elements) {
+			const auto* ui_font = ve.text().getFont();
+			if (!ui_font) continue;
+			if (const auto font_it = own_fonts.find(ui_font); font_it != own_fonts.end()) ve.text().setFont(*font_it->second);
+		}
+
+		this->draw(snapshot.elements);
+		if (snapshot.input_time) this->record_input_latency(*snapshot.input_time);
+	}
+	window_->setActive(false);
+}
+
+/// \brief Records the time from polling the first input event of a frame until the frame was displayed
+/// \param input_time The time the input event was polled
+void Window::record_input_latency(const time_point_t input_time) {
+	const auto latency = steady_clock_t::now() - input_time;
+	std::unique_lock lock(input_latency_mutex_);
+	input_latency_.record(std::chrono::duration_cast<latency_histogram_t::duration_t>(latency));
+}
+
 /// \brief Processes the polled-for event and dispatches registered events
-/// \details Dispatches the events with the corresponding event marker
+/// \details Dispatches the events with the corresponding event marker through the precompiled
+/// dispatch table of the active scene. Markers without subscribers are skipped entirely
 /// \param event The polled-for event
 void Window::process_event(const sf::Event& event) {
+	CUI_PROFILE_SCOPE("process_event");
 	using EventType = sf::Event::EventType;
 	const auto& type = event.type;
 
+	if (recorder_.is_open()) recorder_.record(event);
+
 	auto& scene = this->active_scene();
-	const auto it = scene.marked_sections().find(type);
-	if (it == scene.marked_sections().end()) return;
+	const auto& table = scene.dispatch_table(type);
+	if (table.empty()) return;
 
 	if (!event_cache["mouse_position"].has_value()) event_cache["mouse_position"] = sf::Vector2f(sf::Mouse::getPosition());
 
@@ -571,21 +2183,37 @@ void Window::process_event(const sf::Event& event) {
 	}
 
 	auto& graph = scene.graph();
-	const auto& node_events = it->second.first;
+	const scene_t::DispatchScope dispatch_scope(scene);
 
-	for (const auto& kvp : it->second.second) {
-		this->dispatch_event(type, kvp.first, event_data_t(event_data.get(), kvp.first));
+	for (const auto& handler : table.global_events) {
+		(*handler.event)(event_data_t(event_data.get(), *handler.name));
 	}
 
+	if (table.node_events.empty()) return;
+
+	// Hidden elements, eg. virtual list rows outside of the viewport, do not catch events
 	const auto [x, y] = std::any_cast<sf::Vector2f>(event_cache["mouse_position"]);
 	for (auto rit = cache_.rbegin(); rit != cache_.rend(); ++rit) {
-		if (rit->getGlobalBounds().contains(x, y)) {
+		if (rit->visible() && rit->getGlobalBounds().contains(x, y)) {
 			const std::size_t index = std::abs(std::distance(cache_.rend(), rit)) - 1;
-			auto& node = index == 0 ? graph.root() : graph[index - 1].data();
-			for (const auto& kvp : node_events) {
-				const auto& event_name = kvp.first;
+			const std::size_t target_index = index - 1;
+			auto& node = index == 0 ? graph.root() : graph[target_index].data();
+			for (const auto& handler : table.node_events) {
+				const auto& event_name = *handler.name;
 				if (node.attached_events().contains(event_name)) {
-					this->dispatch_event(type, event_name, event_data_t(event_data.get(), &node, index - 1, event_name));
+					(*handler.event)(event_data_t(event_data.get(), &node, target_index, event_name));
+					continue;
+				}
+
+				// Route to the nearest ancestor that delegates the event
+				if (index == 0) continue;
+				for (auto idx = graph.get_parent_index(target_index);; idx = graph.get_parent_index(idx)) {
+					auto& ancestor = idx == SceneGraph::root_index ? graph.root() : graph[idx].data();
+					if (ancestor.delegated_events().contains(event_name)) {
+						(*handler.event)(event_data_t(event_data.get(), &ancestor, idx, target_index, event_name));
+						break;
+					}
+					if (idx == SceneGraph::root_index) break;
 				}
 			}
 
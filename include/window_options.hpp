@@ -17,6 +17,9 @@ public:
 	u32 style;
 	sf::ContextSettings ctx_settings;
 	u32 framerate;
+	u32 worker_count = 0;
+	bool inline_timers = false;
+	bool pipelined = false;
 };
 
 }	 // namespace cui
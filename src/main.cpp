@@ -122,17 +122,8 @@ int main() {
 		});
 	});
 
-	// Attaches the registered event `on_click_btn` to the button nodes
-	window->attach_event_to_node("one", "on_click_keypad_btn");
-	window->attach_event_to_node("two", "on_click_keypad_btn");
-	window->attach_event_to_node("three", "on_click_keypad_btn");
-	window->attach_event_to_node("four", "on_click_keypad_btn");
-	window->attach_event_to_node("five", "on_click_keypad_btn");
-	window->attach_event_to_node("six", "on_click_keypad_btn");
-	window->attach_event_to_node("seven", "on_click_keypad_btn");
-	window->attach_event_to_node("eight", "on_click_keypad_btn");
-	window->attach_event_to_node("nine", "on_click_keypad_btn");
-	window->attach_event_to_node("zero", "on_click_keypad_btn");
+	// Attaches the registered event `on_click_keypad_btn` to every node styled as a `button`
+	window->attach_event_to_style("button", "on_click_keypad_btn");
 	window->attach_event_to_node("clear", "on_click_clear_btn");
 
 	// Initialize the window
@@ -0,0 +1,57 @@
+#include <test.hpp>
+#include <window.hpp>
+
+using namespace cui;
+using namespace std::chrono_literals;
+
+constexpr char styles__[] = R"(
+root {
+	background: rgb(116, 109, 105);
+}
+
+panel {
+	background: rgb(40, 40, 40);
+	x: 10;
+	width: 400;
+	height: 300;
+}
+)";
+
+constexpr char menu__[] = R"(
+panel "panel"
+)";
+
+constexpr char settings__[] = R"(
+options "panel"
+)";
+
+/// \brief Animations of a scene are dropped once another scene becomes active
+void scene_change_drops_animations() {
+	Window window(test::parse_styles<styles__>(), test::parse_scene<menu__>(), test::parse_scene<settings__>());
+	window.simulate(0ms, 1ms);
+
+	bool finished = false;
+	window.animate("panel", VisualAttribute::X, 200, 100ms, easing::linear, [&finished] { finished = true; });
+	window.simulate(20ms, 1ms);
+	CUI_CHECK(window.animator().size() == 1);
+
+	window.scenes().change_tracked_item(1);
+	window.update_cache();
+	window.simulate(200ms, 1ms);
+
+	const auto& options = *window.active_scene().graph().find_node("options");
+	CUI_CHECK(window.animator().empty());
+	CUI_CHECK(!finished);
+	CUI_CHECK(options.default_schematic().x().integer_value() == 10);
+
+	// Animations on the new scene run as usual
+	window.animate("options", VisualAttribute::X, 50, 10ms, easing::linear, [&finished] { finished = true; });
+	window.simulate(20ms, 1ms);
+	CUI_CHECK(finished);
+	CUI_CHECK(options.default_schematic().x().integer_value() == 50);
+}
+
+int main() {
+	scene_change_drops_animations();
+	return test::report();
+}
@@ -0,0 +1,93 @@
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <coroutine.hpp>
+#include <test.hpp>
+#include <window.hpp>
+
+#ifndef CUI_HAS_COROUTINES
+#error "The coroutine test has to be compiled with coroutine support"
+#endif
+
+using namespace cui;
+using namespace std::chrono_literals;
+
+constexpr char styles__[] = R"(
+root {
+	background: rgb(116, 109, 105);
+}
+)";
+
+constexpr char scene__[] = R"(
+panel "root"
+)";
+
+/// \brief Records every step of the coroutine and the thread it ran on
+Task steps(Window& window, std::vector<int>& done, std::vector<std::thread::id>& threads) {
+	done.push_back(1);
+	co_await window.next_frame();
+	done.push_back(2);
+	threads.push_back(std::this_thread::get_id());
+
+	co_await window.delay(50ms);
+	done.push_back(3);
+	threads.push_back(std::this_thread::get_id());
+
+	const auto value = co_await window.run_on_worker([] { return 42; });
+	done.push_back(value);
+	threads.push_back(std::this_thread::get_id());
+}
+
+/// \brief Catches the exception of a worker job on the window thread
+Task failing_job(Window& window, bool& caught) {
+	try {
+		co_await window.run_on_worker([]() -> int { throw std::runtime_error("job failed"); });
+	} catch (const std::runtime_error&) {
+		caught = true;
+	}
+}
+
+/// \brief Runs frames until a condition holds, worker jobs finish on their own time
+template <typename Condition>
+bool run_until(Window& window, Condition&& condition) {
+	for (int i = 0; i < 1000 && !condition(); ++i) {
+		window.simulate(1ms, 1ms);
+		std::this_thread::sleep_for(1ms);
+	}
+	return condition();
+}
+
+/// \brief Every awaitable resumes the task on the window thread at the right time
+void awaitables_resume_on_the_window_thread() {
+	Window window(test::parse_styles<styles__>(), test::parse_scene<scene__>());
+	window.workers() = std::make_shared<WorkerPool>(1);
+	window.simulate(0ms, 1ms);
+
+	std::vector<int> done;
+	std::vector<std::thread::id> threads;
+	steps(window, done, threads);
+	CUI_CHECK(done == std::vector<int>{1});
+
+	window.simulate(1ms, 1ms);
+	CUI_CHECK(done == (std::vector<int>{1, 2}));
+
+	window.simulate(40ms, 1ms);
+	CUI_CHECK(done == (std::vector<int>{1, 2}));
+	window.simulate(20ms, 1ms);
+	CUI_CHECK(done.size() >= 3 && done[2] == 3);
+
+	CUI_CHECK(run_until(window, [&done] { return done.size() == 4; }));
+	CUI_CHECK(done.back() == 42);
+	for (const auto id : threads) CUI_CHECK(id == std::this_thread::get_id());
+
+	bool caught = false;
+	failing_job(window, caught);
+	CUI_CHECK(run_until(window, [&caught] { return caught; }));
+}
+
+int main() {
+	awaitables_resume_on_the_window_thread();
+	return test::report();
+}
@@ -0,0 +1,97 @@
+#include <future>
+#include <memory>
+#include <string>
+
+#include <test.hpp>
+#include <window.hpp>
+
+using namespace cui;
+using namespace std::chrono_literals;
+
+constexpr char styles__[] = R"(
+root {
+	background: rgb(116, 109, 105);
+}
+)";
+
+constexpr char scene__[] = R"(
+panel "root"
+	first "root"
+	second "root"
+)";
+
+/// \brief A snapshot owns its names and resolves its caller by index until the graph changes, then by name
+void snapshot_resolves_caller() {
+	Window window(test::parse_styles<styles__>(), test::parse_scene<scene__>());
+	window.simulate(0ms, 1ms);
+	auto& graph = window.active_scene().graph();
+
+	const auto index = *graph.find_index("second");
+	Window::async_event_data_t snapshot;
+	{
+		const std::string event_name = "on_click";
+		const Window::event_data_t event_data(sf::Event::MouseButtonEvent{}, &graph[index].data(), index, event_name);
+		snapshot = Window::async_event_data_t(event_data, graph.generation());
+	}
+	CUI_CHECK(snapshot.event_name() == "on_click");
+	CUI_CHECK(snapshot.caller_name() == "second");
+	CUI_CHECK(window.resolve_caller(snapshot) == &graph[index].data());
+
+	// An insertion in front of the caller shifts its index
+	const auto generation = graph.generation();
+	Window::tree_t rows;
+	rows.add_node(Node(std::string("inserted"), std::string()));
+	window.insert_subtree("panel", std::move(rows), 0);
+	CUI_CHECK(graph.generation() != generation);
+	CUI_CHECK(window.resolve_caller(snapshot) == graph.find_node("second"));
+
+	window.remove_subtree("second");
+	CUI_CHECK(window.resolve_caller(snapshot) == nullptr);
+	CUI_CHECK(window.resolve_caller(Window::async_event_data_t()) == nullptr);
+}
+
+/// \brief An async handler keeps working with its snapshot while the graph changes under it
+void async_handler_outlives_dispatch() {
+	Window window(test::parse_styles<styles__>(), test::parse_scene<scene__>());
+	window.simulate(0ms, 1ms);
+	window.workers() = std::make_shared<WorkerPool>(1);
+	auto& graph = window.active_scene().graph();
+
+	std::promise<void> release;
+	auto released = release.get_future().share();
+	std::promise<void> finished;
+	std::string caller_name;
+	const Node* resolved = nullptr;
+
+	window.register_async_event(sf::Event::MouseButtonPressed,
+								"on_click",
+								[&, released](const Window::async_event_data_t& event_data, const Window::task_handle_t& handle) {
+									released.wait();
+									caller_name = event_data.caller_name();
+									window.post_to_ui(handle, [&window, &resolved, event_data] { resolved = window.resolve_caller(event_data); });
+									finished.set_value();
+								});
+
+	const auto index = *graph.find_index("second");
+	window.dispatch_event(sf::Event::MouseButtonPressed,
+						  "on_click",
+						  Window::event_data_t(sf::Event::MouseButtonEvent{}, &graph[index].data(), index, "on_click"));
+
+	// The caller moves and its old slot is reused before the handler reads the snapshot
+	window.remove_subtree("first");
+	Window::tree_t rows;
+	rows.add_node(Node(std::string("inserted"), std::string()));
+	window.insert_subtree("panel", std::move(rows));
+	release.set_value();
+
+	finished.get_future().wait();
+	window.apply_ui_tasks();
+	CUI_CHECK(caller_name == "second");
+	CUI_CHECK(resolved != nullptr && resolved->name() == "second");
+}
+
+int main() {
+	snapshot_resolves_caller();
+	async_handler_outlives_dispatch();
+	return test::report();
+}
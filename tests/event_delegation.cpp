@@ -0,0 +1,81 @@
+#include <string>
+#include <vector>
+
+#include <test.hpp>
+#include <window.hpp>
+
+using namespace cui;
+using namespace std::chrono_literals;
+
+constexpr char styles__[] = R"(
+root {
+	background: rgb(116, 109, 105);
+}
+
+panel {
+	background: rgb(40, 40, 40);
+	width: 400;
+	height: 300;
+}
+
+button {
+	background: rgb(80, 80, 80);
+	x: 10;
+	y: 10;
+	width: 100;
+	height: 50;
+}
+
+label {
+	background: rgb(200, 200, 200);
+	x: 10;
+	y: 100;
+	width: 100;
+	height: 50;
+}
+)";
+
+constexpr char scene__[] = R"(
+panel "panel"
+	button "button"
+	label "label"
+)";
+
+/// \brief Presses the left mouse button at a position of the window
+void press(Window& window, const int x, const int y) {
+	sf::Event event{};
+	event.type = sf::Event::MouseButtonPressed;
+	event.mouseButton = {sf::Mouse::Left, x, y};
+	window.process_event(event);
+}
+
+/// \brief A target with the event attached handles it, its delegating container only gets the other targets
+void delegated_event_fires_once() {
+	Window window(test::parse_styles<styles__>(), test::parse_scene<scene__>());
+	window.simulate(0ms, 1ms);
+	auto& graph = window.active_scene().graph();
+
+	std::vector<std::string> callers;
+	std::vector<std::size_t> targets;
+	window.register_event(sf::Event::MouseButtonPressed, "click", [&callers, &targets](Window::event_data_t data) {
+		callers.push_back(data.caller()->name());
+		targets.push_back(data.target_index());
+	});
+	window.attach_event_to_node("button", "click");
+	window.delegate_event_to_node("panel", "click");
+
+	press(window, 50, 30);
+	CUI_CHECK(callers == std::vector<std::string>{"button"});
+	CUI_CHECK(targets == std::vector<std::size_t>{*graph.find_index("button")});
+
+	callers.clear();
+	targets.clear();
+	press(window, 50, 120);
+	CUI_CHECK(callers == std::vector<std::string>{"panel"});
+	CUI_CHECK(targets == std::vector<std::size_t>{*graph.find_index("label")});
+}
+
+int main() {
+	delegated_event_fires_once();
+	return test::report();
+}
@@ -0,0 +1,80 @@
+#include <filesystem>
+#include <string>
+#include <thread>
+
+#include <test.hpp>
+#include <window.hpp>
+
+using namespace cui;
+using namespace std::chrono_literals;
+
+constexpr char styles__[] = R"(
+root {
+	background: rgb(116, 109, 105);
+}
+)";
+
+constexpr char scene__[] = R"(
+panel "root"
+)";
+
+/// \brief Writes five mouse moves, 10ms apart, to a temporary recording
+auto write_recording() -> std::string {
+	const auto path = (std::filesystem::temp_directory_path() / "cui_event_recorder_test.bin").string();
+	EventRecorder recorder(path);
+	const auto start = EventRecorder::steady_clock_t::now();
+
+	sf::Event event{};
+	event.type = sf::Event::MouseMoved;
+	for (int i = 1; i <= 5; ++i) {
+		event.mouseMove = {i, i};
+		recorder.record(event, start + i * 10ms);
+	}
+	recorder.close();
+	return path;
+}
+
+/// \brief The per event timings include the step run after the event
+void replay_times_the_step() {
+	EventReplayer replayer(write_recording());
+
+	int consumed = 0;
+	const auto stats = replayer.replay([&consumed](const sf::Event&) { ++consumed; },
+									   EventReplayer::Speed::Maximum,
+									   [](std::chrono::nanoseconds) { std::this_thread::sleep_for(2ms); });
+
+	CUI_CHECK(consumed == 5);
+	CUI_CHECK(stats.event_count == 5);
+	CUI_CHECK(stats.processing_duration >= 10ms);
+	CUI_CHECK(stats.max_event_duration >= 2ms);
+	CUI_CHECK(stats.recorded_duration >= 50ms);
+}
+
+/// \brief A maximum speed replay moves the window clock along the recording so timers fire
+void replay_follows_the_recording() {
+	EventReplayer replayer(write_recording());
+
+	Window window(test::parse_styles<styles__>(), test::parse_scene<scene__>());
+	window.simulate(0ms, 1ms);
+	const auto start = window.clock().now();
+
+	bool fired = false;
+	window.timer_schedule(start + 25ms, [&fired] { fired = true; });
+
+	const auto stats = window.replay_events(replayer, EventReplayer::Speed::Maximum);
+	CUI_CHECK(stats.event_count == 5);
+	CUI_CHECK(fired);
+	CUI_CHECK(window.clock().now() - start >= 40ms);
+
+	// A real clock is switched to virtual for the replay only
+	Window fresh(test::parse_styles<styles__>(), test::parse_scene<scene__>());
+	CUI_CHECK(!fresh.clock().is_virtual());
+	fresh.replay_events(replayer, EventReplayer::Speed::Maximum);
+	CUI_CHECK(!fresh.clock().is_virtual());
+}
+
+int main() {
+	replay_times_the_step();
+	replay_follows_the_recording();
+	return test::report();
+}
@@ -0,0 +1,199 @@
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cui/containers/preorder_tree.hpp>
+#include <test.hpp>
+
+using namespace cui;
+
+using tree_t = PreorderTree<std::string>;
+using names_t = std::vector<std::string>;
+
+/// \brief The names of the nodes in index order
+template <typename Tree>
+auto names(const Tree& tree) -> names_t {
+	names_t result;
+	for (const auto& node : tree) result.push_back(node.data());
+	return result;
+}
+
+/// \brief The names of the nodes of a slice
+template <typename Range>
+auto names_of(const Range& range) -> names_t {
+	names_t result;
+	for (const auto& node : range) result.push_back(node.data());
+	return result;
+}
+
+/// \brief The name of the parent of every node, empty for top level nodes
+template <typename Tree>
+auto parents(const Tree& tree) -> names_t {
+	names_t result;
+	for (const auto& node : tree) result.push_back(node.parent() == tree_t::no_parent ? std::string() : tree[node.parent()].data());
+	return result;
+}
+
+/// \brief Depths, subtree sizes and sibling chains match the parents of the nodes
+bool consistent(const tree_t& tree) {
+	for (std::size_t i = 0; i < tree.length(); ++i) {
+		const auto& node = tree[i];
+		const auto parent = node.parent();
+		if (parent != tree_t::no_parent && parent >= i) return false;
+		if (node.depth() != (parent == tree_t::no_parent ? 0 : tree[parent].depth() + 1)) return false;
+
+		const auto end = tree.subtree_end(i);
+		if (end > tree.length()) return false;
+		for (auto j = i + 1; j < end; ++j) {
+			if (tree[j].parent() < i || tree[j].parent() >= j) return false;
+		}
+		if (end < tree.length() && tree[end].depth() > node.depth()) return false;
+	}
+
+	for (auto idx = tree_t::no_parent;; idx = idx == tree_t::no_parent ? 0 : idx + 1) {
+		if (idx != tree_t::no_parent && idx >= tree.length()) break;
+		std::vector<std::size_t> expected;
+		for (std::size_t j = 0; j < tree.length(); ++j) {
+			if (tree[j].parent() == idx) expected.push_back(j);
+		}
+		std::vector<std::size_t> chained;
+		tree.for_each_child(idx, [&chained](const std::size_t child) { chained.push_back(child); });
+		if (chained != expected) return false;
+	}
+	return true;
+}
+
+/// \brief a(b(c), d), e(f) in pre-order
+auto sample() -> tree_t {
+	NaryTree<std::string> nary;
+	nary.add_node(std::string("a"));
+	nary.add_node(std::string("b"), 0);
+	nary.add_node(std::string("c"), 1);
+	nary.add_node(std::string("d"), 0);
+	nary.add_node(std::string("e"));
+	nary.add_node(std::string("f"), 4);
+	return tree_t(nary);
+}
+
+/// \brief x(y)
+auto branch() -> tree_t {
+	tree_t tree;
+	tree.add_node("x");
+	tree.add_node("y", 0);
+	return tree;
+}
+
+/// \brief A tree stored out of order is converted to pre-order and back without losing structure
+void round_trips_nary_tree() {
+	NaryTree<std::string> nary;
+	nary.add_node(std::string("a"));
+	nary.add_node(std::string("e"));
+	nary.add_node(std::string("b"), 0);
+	nary.add_node(std::string("f"), 1);
+	nary.add_node(std::string("c"), 2);
+	nary.add_node(std::string("d"), 0);
+
+	const tree_t tree(nary);
+	CUI_CHECK(consistent(tree));
+	CUI_CHECK(names(tree) == (names_t{"a", "b", "c", "d", "e", "f"}));
+	CUI_CHECK(parents(tree) == (names_t{"", "a", "b", "a", "", "e"}));
+
+	const auto back = tree.to_nary();
+	CUI_CHECK(names(back) == names(tree));
+	CUI_CHECK(parents(back) == parents(tree));
+	CUI_CHECK(back[0].children() == (std::vector<std::size_t>{1, 3}));
+	CUI_CHECK(back[4].children() == (std::vector<std::size_t>{5}));
+	CUI_CHECK(back[2].depth() == 2);
+
+	const tree_t again(back);
+	CUI_CHECK(names(again) == names(tree));
+	CUI_CHECK(parents(again) == parents(tree));
+}
+
+/// \brief Subtrees are the contiguous slices starting at their node
+void subtrees_are_slices() {
+	const auto tree = sample();
+	CUI_CHECK(names_of(tree.subtree(0)) == (names_t{"a", "b", "c", "d"}));
+	CUI_CHECK(names_of(tree.subtree(1)) == (names_t{"b", "c"}));
+	CUI_CHECK(names_of(tree.subtree(3)) == (names_t{"d"}));
+	CUI_CHECK(names_of(tree.subtree(4)) == (names_t{"e", "f"}));
+	CUI_CHECK(tree.first_child(0) == 1);
+	CUI_CHECK(tree.first_child(3) == tree_t::npos);
+}
+
+/// \brief Inserting as the first, a middle and the last child places one slice and remaps the rest
+void insert_remaps_indices() {
+	{
+		auto tree = sample();
+		const auto remap = tree.insert_subtree(0, branch(), 0);
+		CUI_CHECK(remap.is_insertion() && remap.position() == 1 && remap.inserted() == 2);
+		CUI_CHECK(remap.map(0) == 0 && remap.map(1) == 3 && remap.map(5) == 7);
+		CUI_CHECK(names(tree) == (names_t{"a", "x", "y", "b", "c", "d", "e", "f"}));
+		CUI_CHECK(parents(tree) == (names_t{"", "a", "x", "a", "b", "a", "", "e"}));
+		CUI_CHECK(names_of(tree.subtree(0)) == (names_t{"a", "x", "y", "b", "c", "d"}));
+		CUI_CHECK(consistent(tree));
+	}
+	{
+		auto tree = sample();
+		const auto remap = tree.insert_subtree(0, branch(), 1);
+		CUI_CHECK(remap.position() == 3 && remap.inserted() == 2);
+		CUI_CHECK(remap.map(2) == 2 && remap.map(3) == 5);
+		CUI_CHECK(names(tree) == (names_t{"a", "b", "c", "x", "y", "d", "e", "f"}));
+		CUI_CHECK(consistent(tree));
+	}
+	{
+		auto tree = sample();
+		const auto remap = tree.insert_subtree(0, branch());
+		CUI_CHECK(remap.position() == 4 && remap.inserted() == 2);
+		CUI_CHECK(remap.map(3) == 3 && remap.map(4) == 6);
+		CUI_CHECK(names(tree) == (names_t{"a", "b", "c", "d", "x", "y", "e", "f"}));
+		CUI_CHECK(consistent(tree));
+	}
+	{
+		auto tree = sample();
+		const auto remap = tree.insert_subtree(tree_t::no_parent, branch());
+		CUI_CHECK(remap.position() == 6 && remap.inserted() == 2);
+		CUI_CHECK(names(tree) == (names_t{"a", "b", "c", "d", "e", "f", "x", "y"}));
+		CUI_CHECK(parents(tree) == (names_t{"", "a", "b", "a", "", "e", "", "x"}));
+		CUI_CHECK(consistent(tree));
+	}
+}
+
+/// \brief Removing the first, a middle and the last subtree erases one slice and remaps the rest
+void remove_remaps_indices() {
+	{
+		auto tree = sample();
+		const auto remap = tree.remove_subtree(0);
+		CUI_CHECK(remap.removed() == (std::vector<std::size_t>{0, 1, 2, 3}));
+		CUI_CHECK(remap.map(2) == tree_t::npos && remap.map(4) == 0 && remap.map(5) == 1);
+		CUI_CHECK(names(tree) == (names_t{"e", "f"}));
+		CUI_CHECK(consistent(tree));
+	}
+	{
+		auto tree = sample();
+		const auto remap = tree.remove_subtree(1);
+		CUI_CHECK(remap.removed() == (std::vector<std::size_t>{1, 2}));
+		CUI_CHECK(remap.map(0) == 0 && remap.map(1) == tree_t::npos && remap.map(3) == 1 && remap.map(5) == 3);
+		CUI_CHECK(names(tree) == (names_t{"a", "d", "e", "f"}));
+		CUI_CHECK(parents(tree) == (names_t{"", "a", "", "e"}));
+		CUI_CHECK(names_of(tree.subtree(0)) == (names_t{"a", "d"}));
+		CUI_CHECK(consistent(tree));
+	}
+	{
+		auto tree = sample();
+		const auto remap = tree.remove_subtree(5);
+		CUI_CHECK(remap.removed() == (std::vector<std::size_t>{5}));
+		CUI_CHECK(remap.map(4) == 4);
+		CUI_CHECK(names(tree) == (names_t{"a", "b", "c", "d", "e"}));
+		CUI_CHECK(!tree[4].has_children());
+		CUI_CHECK(consistent(tree));
+	}
+}
+
+int main() {
+	round_trips_nary_tree();
+	subtrees_are_slices();
+	insert_remaps_indices();
+	remove_remaps_indices();
+	return test::report();
+}
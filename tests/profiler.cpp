@@ -0,0 +1,74 @@
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <regex>
+#include <string>
+#include <thread>
+
+#include <detail/profiler.hpp>
+#include <test.hpp>
+
+using namespace cui;
+using namespace std::chrono_literals;
+
+/// \brief Records an outer scope around an inner one
+void record_nested() {
+	CUI_PROFILE_SCOPE("outer");
+	std::this_thread::sleep_for(1ms);
+	{
+		CUI_PROFILE_SCOPE("inner");
+		std::this_thread::sleep_for(1ms);
+	}
+}
+
+/// \brief Nested scopes are recorded in the order they end and start after the epoch
+void nested_scopes_are_ordered() {
+	// Runs first, before anything else touches the profiler
+	record_nested();
+
+	const auto samples = Profiler::instance().samples();
+	CUI_CHECK(samples.size() == 2);
+	if (samples.size() != 2) return;
+
+	const auto& inner = samples[0];
+	const auto& outer = samples[1];
+	CUI_CHECK(std::string(inner.name) == "inner");
+	CUI_CHECK(std::string(outer.name) == "outer");
+	CUI_CHECK(outer.start <= inner.start);
+	CUI_CHECK(inner.start + inner.duration <= outer.start + outer.duration);
+	CUI_CHECK(inner.duration >= 1'000'000u);
+	// A start before the epoch would wrap around to a huge value
+	CUI_CHECK(outer.start < 60'000'000'000u);
+}
+
+/// \brief The exported trace holds every sample with microsecond times and a fixed nanosecond fraction
+void chrome_trace_is_exported() {
+	const std::string path = "profiler_test_trace.json";
+	CUI_CHECK(Profiler::instance().write_chrome_trace(path));
+
+	std::ifstream stream(path);
+	const std::string json((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+	stream.close();
+	std::remove(path.c_str());
+
+	CUI_CHECK(json.find("{\"traceEvents\":[") == 0);
+	CUI_CHECK(json.find("\"displayTimeUnit\":\"ms\"") != std::string::npos);
+	CUI_CHECK(json.find("e+") == std::string::npos);
+
+	const std::regex event(R"re(\{"name":"(inner|outer)","ph":"X","pid":1,"tid":\d+,"ts":\d+\.\d{3},"dur":\d+\.\d{3}\})re");
+	const auto events = std::distance(std::sregex_iterator(json.begin(), json.end(), event), std::sregex_iterator());
+	CUI_CHECK(events == 2);
+}
+
+/// \brief Clearing drops the samples
+void clear_drops_samples() {
+	Profiler::instance().clear();
+	CUI_CHECK(Profiler::instance().samples().empty());
+}
+
+int main() {
+	nested_scopes_are_ordered();
+	chrome_trace_is_exported();
+	clear_drops_samples();
+	return test::report();
+}
@@ -0,0 +1,84 @@
+#include <string>
+
+#include <render_cache.hpp>
+#include <test.hpp>
+#include <window.hpp>
+
+using namespace cui;
+
+constexpr char styles__[] = R"(
+panel {
+	background: url(assets/panel.png);
+	font: url(assets/bebas_neue.ttf);
+	width: 400;
+	height: 300;
+}
+)";
+
+constexpr char scene__[] = R"(
+panel "panel" <Panel>
+)";
+
+/// \brief Nodes sharing one schematic block whose only paths are in an event schematic are cached separately
+void shared_event_background() {
+	Node prototype(std::string("row"), std::string());
+	prototype.event_schematics()["hover"].background() = std::string("assets/row_hovered.png");
+	prototype.event_schematics()["hover"].font() = std::string("assets/font.ttf");
+
+	auto first = prototype;
+	auto second = prototype;
+	CUI_CHECK(first.shares_schematics());
+
+	RenderCache cache;
+	cache.cache_resource(first);
+	cache.cache_resource(second);
+
+	for (const auto* node : {&first, &second}) {
+		CUI_CHECK(node->event_schematics().at("hover").background().string() == "row_hovered.png");
+		CUI_CHECK(node->event_schematics().at("hover").font().string() == "font.ttf");
+	}
+	CUI_CHECK(prototype.event_schematics().at("hover").background().string() == "assets/row_hovered.png");
+	CUI_CHECK(cache.textures.size() == 1);
+	CUI_CHECK(cache.fonts.size() == 1);
+
+	// Paths already replaced are not written again, copies of a cached node keep sharing
+	auto third = first;
+	cache.cache_resource(third);
+	CUI_CHECK(third.shares_schematics());
+	CUI_CHECK(third.same_schematics(first));
+}
+
+/// \brief Elements keep pointing at their resources while nodes with new resources are inserted
+void runtime_resources_keep_addresses() {
+	Window window(test::parse_styles<styles__>(), test::parse_scene<scene__>());
+	window.simulate(std::chrono::milliseconds(0), std::chrono::milliseconds(1));
+	const auto& cache = window.cache();
+	const auto panel = *window.active_scene().graph().find_index("panel");
+	const auto* texture = cache[panel + 1].getTexture();
+	const auto* font = cache[panel + 1].text().getFont();
+	CUI_CHECK(texture == cache.textures.at("panel.png").get());
+
+	// Enough new resources to make the maps grow
+	for (auto i = 0; i < 64; ++i) {
+		const auto index = std::to_string(i);
+		Node node("row" + index, std::string());
+		node.default_schematic().background() = "assets/row" + index + ".png";
+		node.default_schematic().font() = "assets/font" + index + ".ttf";
+		SceneGraph::tree_t tree;
+		tree.add_node(std::move(node));
+		window.insert_subtree("panel", std::move(tree));
+	}
+
+	CUI_CHECK(cache.textures.size() == 65);
+	CUI_CHECK(cache.textures.at("panel.png").get() == texture);
+	CUI_CHECK(cache.fonts.at("bebas_neue.ttf").get() == font);
+	CUI_CHECK(cache[panel + 1].getTexture() == texture);
+	const auto row = *window.active_scene().graph().find_index("row0");
+	CUI_CHECK(cache[row + 1].getTexture() == cache.textures.at("row0.png").get());
+}
+
+int main() {
+	shared_event_background();
+	runtime_resources_keep_addresses();
+	return test::report();
+}
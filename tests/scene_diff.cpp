@@ -0,0 +1,144 @@
+#include <random>
+#include <string>
+
+#include <test.hpp>
+#include <window.hpp>
+
+using namespace cui;
+
+constexpr char styles__[] = R"(
+root {
+	background: rgb(116, 109, 105);
+}
+
+panel {
+	background: url(assets/panel.png);
+	width: 400;
+	height: 300;
+}
+
+button {
+	background: url(assets/button.png);
+	font: url(assets/bebas_neue.ttf);
+	x: center;
+	y: 70%;
+	width: 350;
+	height: 100;
+}
+)";
+
+constexpr char scene__[] = R"(
+panel "panel"
+	title "button" <Title>
+	ok "button" <Ok>
+	cancel "button" <Cancel>
+footer "button" <Footer>
+)";
+
+constexpr char changed_scene__[] = R"(
+panel "panel"
+	cancel "button" <Cancel>
+	ok "button" <Okay>
+	help "button" <Help>
+footer "button" <Footer>
+)";
+
+/// \brief Patching a live graph with the tree it was built from changes nothing
+void patch_with_source() {
+	const auto styles = test::parse_styles<styles__>();
+	Window window(styles, test::parse_scene<scene__>());
+	window.simulate(std::chrono::milliseconds(0), std::chrono::milliseconds(1));
+
+	const auto diff = window.patch(SceneGraph(test::parse_scene<scene__>(), styles));
+	CUI_CHECK(diff.empty());
+}
+
+/// \brief A patched graph matches its target and patching it again yields no edits
+void patch_round_trip() {
+	const auto styles = test::parse_styles<styles__>();
+	Window window(styles, test::parse_scene<scene__>());
+	window.simulate(std::chrono::milliseconds(0), std::chrono::milliseconds(1));
+
+	const SceneGraph changed(test::parse_scene<changed_scene__>(), styles);
+	const auto diff = window.patch(changed);
+	CUI_CHECK(diff.count(SceneDiff::Kind::Insert) == 1);
+	CUI_CHECK(diff.count(SceneDiff::Kind::Remove) == 1);
+	CUI_CHECK(diff.count(SceneDiff::Kind::Update) == 1);
+	CUI_CHECK(window.patch(changed).empty());
+
+	const auto& graph = window.active_scene().graph();
+	CUI_CHECK(graph.length() == changed.length());
+	const auto panel = graph.find_index("panel");
+	CUI_CHECK(panel.has_value());
+	if (panel) {
+		const auto& children = graph[*panel].children();
+		CUI_CHECK(children.size() == 3);
+		CUI_CHECK(graph[children[0]].data().name() == "cancel");
+		CUI_CHECK(graph[children[2]].data().name() == "help");
+	}
+	const auto ok = graph.find_index("ok");
+	CUI_CHECK(ok && graph[*ok].data().text() == "Okay");
+	CUI_CHECK(!graph.find_index("title"));
+	CUI_CHECK(window.patch(SceneGraph(test::parse_scene<scene__>(), styles)).count(SceneDiff::Kind::Remove) == 1);
+}
+
+/// \brief Names, texts and depths of a tree in pre-order
+auto dump(const SceneDiff::tree_t& tree) -> std::string {
+	std::string result;
+	std::vector<std::size_t> pending;
+	for (auto i = tree.length(); i-- > 0;) {
+		if (tree[i].parent() == SceneDiff::tree_t::no_parent) pending.push_back(i);
+	}
+	while (!pending.empty()) {
+		const auto current = pending.back();
+		pending.pop_back();
+		result += std::to_string(tree[current].depth()) + tree[current].data().name() + '=' + tree[current].data().text() + ';';
+		const auto& children = tree[current].children();
+		pending.insert(pending.end(), children.rbegin(), children.rend());
+	}
+	return result;
+}
+
+/// \brief A random tree whose names mostly are unique, some repeat like the parts of instanced prototypes
+auto random_tree(std::mt19937& rng, const std::size_t length) -> SceneDiff::tree_t {
+	SceneDiff::tree_t tree;
+	std::vector<bool> used(length * 2, false);
+	for (std::size_t i = 0; i < length; ++i) {
+		auto name = std::string("part");
+		if (const auto key = rng() % used.size(); rng() % 4 != 0 && !used[key]) {
+			used[key] = true;
+			name = "node" + std::to_string(key);
+		}
+		Node node(name, std::to_string(rng() % 3));
+		node.default_schematic().x() = static_cast<int>(rng() % 2);
+		if (i == 0 || rng() % 5 == 0) {
+			tree.add_node(node);
+		} else {
+			tree.add_node(node, rng() % tree.length());
+		}
+	}
+	return tree;
+}
+
+/// \brief Random live graphs are turned into random targets through inserts, moves, updates and removals
+void patch_random() {
+	const auto styles = test::parse_styles<styles__>();
+	std::mt19937 rng(7);
+	for (auto round = 0; round < 200; ++round) {
+		Window window(styles, test::parse_scene<scene__>());
+		window.simulate(std::chrono::milliseconds(0), std::chrono::milliseconds(1));
+		window.patch(random_tree(rng, 1 + rng() % 40));
+
+		const auto target = random_tree(rng, 1 + rng() % 40);
+		window.patch(target);
+		CUI_CHECK(dump(window.active_scene().graph()) == dump(target));
+		CUI_CHECK(window.patch(target).empty());
+	}
+}
+
+int main() {
+	patch_with_source();
+	patch_round_trip();
+	patch_random();
+	return test::report();
+}
@@ -0,0 +1,222 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cui/visual/scene_graph.hpp>
+#include <test.hpp>
+
+using namespace cui;
+
+using indices_t = std::vector<SceneGraph::size_type>;
+
+constexpr char styles__[] = R"(
+panel {
+	width: 400;
+	height: 300;
+}
+
+button {
+	width: 100;
+	height: 50;
+}
+
+label {
+	width: 80;
+	height: 20;
+}
+)";
+
+constexpr char scene__[] = R"(
+panel "panel"
+	first "button"
+	second "button"
+footer "button"
+)";
+
+/// \brief A node with a style class, like the nodes of a parsed scene
+auto styled(const std::string& name, const std::string& style_class) -> Node {
+	Node node(name, std::string());
+	node.style_classes().push_back(style_class);
+	return node;
+}
+
+/// \brief A row with a label below it
+auto row(const std::string& name) -> SceneGraph::tree_t {
+	SceneGraph::tree_t tree;
+	tree.add_node(styled(name, "button"));
+	tree.add_node(styled("label", "label"), 0);
+	return tree;
+}
+
+/// \brief The name and style class indices match a scan of the nodes
+bool indices_match(const SceneGraph& graph) {
+	tsl::hopscotch_map<std::string, SceneGraph::size_type> counts;
+	tsl::hopscotch_map<std::string, indices_t> styles;
+	for (SceneGraph::size_type i = 0; i < graph.length(); ++i) {
+		const auto& node = graph[i].data();
+		++counts[node.name()];
+		for (const auto& style_class : node.style_classes()) styles[style_class].push_back(i);
+	}
+
+	for (const auto& [name, count] : counts) {
+		const auto index = graph.find_index(name);
+		if (!index || graph[*index].data().name() != name) return false;
+
+		const auto it = graph.duplicate_names().find(name);
+		const auto duplicates = it == graph.duplicate_names().end() ? 0 : it->second;
+		if (duplicates != count - 1) return false;
+	}
+	if (graph.duplicate_names().size() != static_cast<std::size_t>(std::count_if(counts.begin(), counts.end(), [](const auto& kvp) {
+			return kvp.second > 1;
+		}))) {
+		return false;
+	}
+
+	for (const auto* style_class : {"panel", "button", "label"}) {
+		if (graph.indices_with_style(style_class) != styles[style_class]) return false;
+	}
+	return true;
+}
+
+/// \brief Inserting and removing subtrees remaps the children, parents, names and style classes of every node
+void insert_and_remove_remap_indices() {
+	SceneGraph graph(test::parse_scene<scene__>(), test::parse_styles<styles__>());
+	CUI_CHECK(graph.indices_with_style("button") == (indices_t{1, 2, 3}));
+	CUI_CHECK(graph[1].data().style_classes() == std::vector<std::string>{"button"});
+
+	// In front of the first child of the panel
+	graph.insert_subtree(0, row("row"), 0);
+	CUI_CHECK(graph[0].children() == (indices_t{1, 3, 4}));
+	CUI_CHECK(graph[1].children() == (indices_t{2}));
+	CUI_CHECK(graph.get_parent_index(2) == 1 && graph.get_parent_index(4) == 0);
+	CUI_CHECK(graph.find_index("first") == 3u && graph.find_index("footer") == 5u && graph.find_index("label") == 2u);
+	CUI_CHECK(graph.indices_with_style("button") == (indices_t{1, 3, 4, 5}));
+	CUI_CHECK(graph.indices_with_style("label") == (indices_t{2}));
+	CUI_CHECK(indices_match(graph));
+
+	graph.remove_subtree(*graph.find_index("first"));
+	CUI_CHECK(!graph.find_index("first"));
+	CUI_CHECK(graph[0].children() == (indices_t{1, 3}));
+	CUI_CHECK(graph.indices_with_style("button") == (indices_t{1, 3, 4}));
+	CUI_CHECK(indices_match(graph));
+
+	graph.remove_subtree(*graph.find_index("row"));
+	CUI_CHECK(!graph.find_index("row") && !graph.find_index("label"));
+	CUI_CHECK(graph.find_index("second") == 1u && graph.find_index("footer") == 2u);
+	CUI_CHECK(graph.indices_with_style("button") == (indices_t{1, 2}));
+	CUI_CHECK(graph.indices_with_style("label").empty());
+	CUI_CHECK(indices_match(graph));
+}
+
+/// \brief A name carried by several nodes is reported and handed over when its node is removed
+void duplicate_names_are_reported() {
+	SceneGraph graph(test::parse_scene<scene__>(), test::parse_styles<styles__>());
+	graph.insert_subtree(0, row("row#0"));
+	graph.insert_subtree(0, row("row#1"));
+
+	const auto first_label = *graph.find_index("label");
+	CUI_CHECK(graph.get_parent_index(first_label) == *graph.find_index("row#0"));
+	CUI_CHECK(graph.duplicate_names().size() == 1 && graph.duplicate_names().at("label") == 1);
+
+	graph.remove_subtree(*graph.find_index("row#0"));
+	CUI_CHECK(graph.duplicate_names().empty());
+	CUI_CHECK(graph.get_parent_index(*graph.find_index("label")) == *graph.find_index("row#1"));
+
+	graph.remove_subtree(*graph.find_index("row#1"));
+	CUI_CHECK(!graph.find_index("label"));
+	CUI_CHECK(indices_match(graph));
+}
+
+/// \brief The node of that name shows its hover schematic
+bool hovered(const SceneGraph& graph, const std::string& name) {
+	const auto& node = graph[*graph.find_index(name)].data();
+	return &node.active_schematic() == &node.event_schematics().at("hover");
+}
+
+/// \brief Nodes shifted by inserts and removals keep their active schematic
+void shifted_nodes_keep_the_active_schematic() {
+	SceneGraph graph(test::parse_scene<scene__>(), test::parse_styles<styles__>());
+	auto& second = graph[*graph.find_index("second")].data();
+	second.event_schematics()["hover"] = second.default_schematic();
+	CUI_CHECK(second.set_active("hover"));
+	CUI_CHECK(hovered(graph, "second"));
+
+	graph.insert_subtree(0, row("row"), 0);
+	CUI_CHECK(graph.find_index("second") == 4u);
+	CUI_CHECK(hovered(graph, "second"));
+
+	graph.remove_subtree(*graph.find_index("row"));
+	CUI_CHECK(graph.find_index("second") == 2u);
+	CUI_CHECK(hovered(graph, "second"));
+}
+
+/// \brief Switching the active schematic of instances keeps their schematics shared
+void switching_schematics_keeps_sharing() {
+	Node prototype(std::string("row"), std::string());
+	prototype.event_schematics()["hover"].width() = 120;
+
+	auto instance = prototype;
+	CUI_CHECK(instance.set_active("hover"));
+	CUI_CHECK(!instance.set_active("pressed"));
+	CUI_CHECK(instance.shares_schematics());
+	CUI_CHECK(&std::as_const(instance).active_schematic() == &std::as_const(prototype).event_schematics().at("hover"));
+	CUI_CHECK(&std::as_const(prototype).active_schematic() == &std::as_const(prototype).default_schematic());
+
+	CUI_CHECK(instance.set_active(std::string()));
+	CUI_CHECK(instance.shares_schematics());
+	CUI_CHECK(&std::as_const(instance).active_schematic() == &std::as_const(prototype).default_schematic());
+}
+
+/// \brief Moving a node hands over its schematics without sharing them with the moved from node
+void moved_nodes_own_their_schematics() {
+	Node node(std::string("row"), std::string());
+	node.event_schematics()["hover"].width() = 120;
+	CUI_CHECK(node.set_active("hover"));
+	const auto* hover = &std::as_const(node).event_schematics().at("hover");
+
+	Node moved_into(std::move(node));
+	CUI_CHECK(!moved_into.shares_schematics());
+	CUI_CHECK(&std::as_const(moved_into).active_schematic() == hover);
+
+	Node assigned;
+	assigned = std::move(moved_into);
+	CUI_CHECK(!assigned.shares_schematics());
+	CUI_CHECK(&std::as_const(assigned).active_schematic() == hover);
+
+	// The moved from node stays usable and writing to it does not reach the other nodes
+	node.default_schematic().width() = 10;
+	CUI_CHECK(!node.shares_schematics());
+	CUI_CHECK(std::as_const(node).event_schematics().empty());
+	CUI_CHECK(&std::as_const(node).active_schematic() == &std::as_const(node).default_schematic());
+	CUI_CHECK(std::as_const(assigned).default_schematic().width().integer_value() != 10);
+}
+
+/// \brief Random inserts and removals keep every index in line with the nodes
+void random_edits_keep_indices() {
+	SceneGraph graph(test::parse_scene<scene__>(), test::parse_styles<styles__>());
+	std::mt19937 rng(3);
+
+	bool matched = true;
+	for (int i = 0; i < 300; ++i) {
+		if (graph.length() > 0 && rng() % 3 == 0) {
+			graph.remove_subtree(rng() % graph.length());
+		} else {
+			const auto parent = graph.length() == 0 || rng() % 4 == 0 ? SceneGraph::root_index : rng() % graph.length();
+			graph.insert_subtree(parent, row("row" + std::to_string(rng() % 8)), rng() % 3);
+		}
+		matched = matched && indices_match(graph);
+	}
+	CUI_CHECK(matched);
+}
+
+int main() {
+	insert_and_remove_remap_indices();
+	duplicate_names_are_reported();
+	shifted_nodes_keep_the_active_schematic();
+	switching_schematics_keeps_sharing();
+	moved_nodes_own_their_schematics();
+	random_edits_keep_indices();
+	return test::report();
+}
@@ -0,0 +1,83 @@
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <scene_state.hpp>
+#include <test.hpp>
+
+using namespace cui;
+
+constexpr char styles__[] = R"(
+root {
+	background: rgb(116, 109, 105);
+}
+)";
+
+constexpr char scene__[] = R"(
+panel "root"
+)";
+
+using scene_t = SceneState<std::function<void(int)>, int, 4>;
+
+auto make_scene() -> scene_t {
+	return scene_t(SceneGraph(test::parse_scene<scene__>(), test::parse_styles<styles__>()));
+}
+
+/// \brief Walks a dispatch table the way \sa Window::process_event does
+void dispatch(scene_t& scene, const int marker) {
+	const auto& table = scene.dispatch_table(marker);
+	const scene_t::DispatchScope dispatch_scope(scene);
+	for (const auto& handler : table.global_events) (*handler.event)(marker);
+}
+
+/// \brief A handler may unregister itself and register enough events to rehash the map while the table is walked
+void changes_during_dispatch() {
+	auto scene = make_scene();
+	std::vector<std::string> calls;
+
+	scene.register_global_event(1, "first", [&](int) {
+		calls.push_back("first");
+		scene.unregister_global_event(1, "first");
+		for (int i = 0; i < 256; ++i) scene.register_global_event(1, "added" + std::to_string(i), [&calls](int) { calls.push_back("added"); });
+	});
+	scene.register_global_event(1, "second", [&](int) {
+		calls.push_back("second");
+		scene.unregister_global_event(1, "second");
+	});
+
+	dispatch(scene, 1);
+	CUI_CHECK(calls.size() == 2);
+	CUI_CHECK(!scene.dispatching());
+	CUI_CHECK(scene.registered_global_events(1).size() == 256);
+	CUI_CHECK(scene.dispatch_table(1).global_events.size() == 256);
+
+	calls.clear();
+	dispatch(scene, 1);
+	CUI_CHECK(calls.size() == 256);
+}
+
+/// \brief Changes made in nested dispatches wait for the outermost one and keep their order
+void nested_dispatch() {
+	auto scene = make_scene();
+	int inner_calls = 0;
+
+	scene.register_global_event(2, "inner", [&](int) { ++inner_calls; });
+	scene.register_global_event(1, "outer", [&](int) {
+		dispatch(scene, 2);
+		scene.unregister_global_event(2, "inner");
+		scene.register_global_event(2, "inner", [&](int) { inner_calls += 10; });
+		CUI_CHECK(scene.dispatching());
+		CUI_CHECK(scene.registered_global_events(2).size() == 1);
+	});
+
+	dispatch(scene, 1);
+	CUI_CHECK(inner_calls == 1);
+	dispatch(scene, 2);
+	CUI_CHECK(inner_calls == 11);
+}
+
+int main() {
+	changes_during_dispatch();
+	nested_dispatch();
+	return test::report();
+}
@@ -0,0 +1,63 @@
+#ifndef CUI_SFML_TESTS_TEST_HPP
+#define CUI_SFML_TESTS_TEST_HPP
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <cui/compile_time/scenes/parse_scenes.hpp>
+#include <cui/compile_time/style.hpp>
+#include <cui/compile_time/styles/parse_styles.hpp>
+
+namespace cui::test {
+
+/// \brief Counts the failed checks of the running test
+[[nodiscard]] inline auto failures() noexcept -> int& {
+	static int count = 0;
+	return count;
+}
+
+/// \brief Records a failed check without stopping the test
+inline void check(const bool passed, const char* expression, const char* file, const int line) {
+	if (passed) return;
+	std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+	++failures();
+}
+
+/// \brief Exit code of the running test
+[[nodiscard]] inline auto report() noexcept -> int {
+	return failures() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/// \brief Parses a .styles string known at compile time, parse errors fail the build
+template <const char* TStyles>
+[[nodiscard]] auto parse_styles() -> std::vector<ct::Style> {
+	constexpr auto styles_variant = ct::styles::parse_styles<TStyles>();
+	static_assert(!styles_variant.is_type_b(), "The test styles do not parse");
+
+	std::vector<ct::Style> styles;
+	styles.reserve(styles_variant.type_a().size());
+	for (const auto& el : styles_variant.type_a()) {
+		const auto parsed_variant = ct::Style::create(el);
+		if (parsed_variant.is_type_b()) {
+			std::fprintf(stderr, "The test styles do not parse\n");
+			std::exit(EXIT_FAILURE);
+		}
+		styles.push_back(parsed_variant.type_a());
+	}
+	return styles;
+}
+
+/// \brief Parses a .scene string known at compile time, parse errors fail the build
+template <const char* TScene>
+[[nodiscard]] constexpr auto parse_scene() {
+	constexpr auto scenes_variant = ct::scenes::parse_scenes<TScene>();
+	static_assert(!scenes_variant.is_type_b(), "The test scene does not parse");
+	return scenes_variant.type_a();
+}
+
+}	 // namespace cui::test
+
+#define CUI_CHECK(expression) ::cui::test::check(static_cast<bool>(expression), #expression, __FILE__, __LINE__)
+
+#endif	  // CUI_SFML_TESTS_TEST_HPP
@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <random>
+#include <vector>
+
+#include <detail/timer_wheel.hpp>
+#include <test.hpp>
+
+using namespace cui;
+using namespace std::chrono_literals;
+
+using time_point_t = TimerWheel::time_point_t;
+
+/// \brief Quantizes a deadline like the wheel does, rounding up to the next millisecond
+auto to_tick(const time_point_t start, const time_point_t deadline) -> u64 {
+	if (deadline <= start) return 0;
+	return static_cast<u64>((deadline - start + 1ms - 1ns) / 1ms);
+}
+
+/// \brief Random schedules, cancels and advances of any length match a sorted reference model
+void matches_reference() {
+	const auto start = time_point_t(1h);
+	TimerWheel wheel(start, 1ms);
+	std::mt19937_64 rng(7);
+
+	// Pending timers by key, with their tick and wheel id
+	std::map<u64, std::pair<u64, TimerWheel::timer_id_t>> pending;
+	std::vector<u64> fired;
+	u64 next_key = 0;
+	u64 now_tick = 0;
+
+	const u64 ranges[] = {4, 300, 70'000, 20'000'000, u64(1) << 33};
+	const auto sink = [&fired, start](TimerEvent&& timer) {
+		fired.push_back(to_tick(start, timer.deadline()));
+		timer();
+	};
+
+	for (int round = 0; round < 4000; ++round) {
+		const auto action = rng() % 8;
+		if (action < 4) {
+			const auto tick = now_tick + rng() % ranges[rng() % 5];
+			const auto deadline = start + std::chrono::nanoseconds(tick * 1'000'000 - rng() % 1'000'000);
+			const auto key = next_key++;
+			const auto id = wheel.schedule(TimerEvent([&pending, key] { pending.erase(key); }, deadline));
+			pending[key] = {to_tick(start, deadline), id};
+		} else if (action < 6 && !pending.empty()) {
+			auto it = pending.begin();
+			std::advance(it, static_cast<long>(rng() % pending.size()));
+			CUI_CHECK(wheel.cancel(it->second.second));
+			CUI_CHECK(!wheel.contains(it->second.second));
+			pending.erase(it);
+		} else {
+			const auto step = rng() % ranges[rng() % 5];
+			now_tick += step;
+
+			auto expected = std::vector<u64>();
+			for (const auto& [key, timer] : pending) {
+				if (timer.first <= now_tick) expected.push_back(timer.first);
+			}
+			std::sort(expected.begin(), expected.end());
+
+			fired.clear();
+			const auto count = wheel.advance(start + now_tick * 1ms + std::chrono::nanoseconds(rng() % 1'000'000), sink);
+			CUI_CHECK(count == expected.size());
+			CUI_CHECK(fired == expected);
+			CUI_CHECK(wheel.current_time() == start + now_tick * 1ms);
+		}
+
+		CUI_CHECK(wheel.size() == pending.size());
+		if (pending.empty()) {
+			CUI_CHECK(!wheel.next_deadline().has_value());
+			continue;
+		}
+
+		// The next deadline is never later than the earliest timer and never in the past
+		auto earliest = pending.begin()->second.first;
+		for (const auto& [key, timer] : pending) earliest = std::min(earliest, timer.first);
+		const auto next = wheel.next_deadline();
+		CUI_CHECK(next.has_value() && *next <= start + earliest * 1ms && *next >= wheel.current_time());
+	}
+}
+
+/// \brief A single advance across a long idle gap fires the timers on both sides of it in order
+void jumps_idle_gaps() {
+	const auto start = time_point_t(1h);
+	TimerWheel wheel(start, 1ms);
+
+	std::vector<int> order;
+	wheel.schedule(TimerEvent([&order] { order.push_back(2); }, start + 90min));
+	wheel.schedule(TimerEvent([&order] { order.push_back(1); }, start + 5ms));
+	wheel.schedule(TimerEvent([&order] { order.push_back(3); }, start + 24h * 100));
+
+	const auto sink = [](TimerEvent&& timer) { timer(); };
+	CUI_CHECK(wheel.advance(start + 2h, sink) == 2);
+	CUI_CHECK((order == std::vector<int>{1, 2}));
+	CUI_CHECK(wheel.next_deadline().has_value());
+
+	CUI_CHECK(wheel.advance(start + 24h * 100, sink) == 1);
+	CUI_CHECK((order == std::vector<int>{1, 2, 3}));
+	CUI_CHECK(wheel.empty() && !wheel.next_deadline().has_value());
+}
+
+/// \brief Timers the sink schedules as already due still expire within the same advance
+void sink_schedules_due_timers() {
+	const auto start = time_point_t(1h);
+	TimerWheel wheel(start, 1ms);
+
+	int fired = 0;
+	wheel.schedule(TimerEvent([] {}, start + 10ms));
+	const auto sink = [&wheel, &fired, start](TimerEvent&&) {
+		if (fired++ == 0) wheel.schedule(TimerEvent([] {}, start));
+	};
+	CUI_CHECK(wheel.advance(start + 1s, sink) == 2);
+	CUI_CHECK(fired == 2 && wheel.empty());
+}
+
+/// \brief Copies of a repeating timer run the callback of the handle instead of wrapping it
+void repeating_copies_share_the_handle() {
+	int fired = 0;
+	const auto handle = TimerHandle::create([&fired] { ++fired; });
+	const TimerEvent timer(handle, time_point_t(1h), 1ms);
+	const auto copy = timer;
+
+	CUI_CHECK(!copy.event());
+	copy();
+	timer();
+	CUI_CHECK(fired == 2);
+
+	handle.cancel();
+	copy();
+	CUI_CHECK(fired == 2 && timer.cancelled());
+}
+
+int main() {
+	matches_reference();
+	jumps_idle_gaps();
+	sink_schedules_due_timers();
+	repeating_copies_share_the_handle();
+	return test::report();
+}
@@ -0,0 +1,40 @@
+#include <stdexcept>
+
+#include <test.hpp>
+#include <ui_command.hpp>
+
+using namespace cui;
+
+/// \brief Checks whether building a command throws a \sa std::logic_error
+template <typename Factory>
+bool rejects(Factory&& factory) {
+	try {
+		static_cast<void>(factory());
+	} catch (const std::logic_error&) {
+		return true;
+	}
+	return false;
+}
+
+/// \brief Attributes only accept values of their own kind
+void set_attribute_checks_the_value_kind() {
+	for (const auto attribute : {VisualAttribute::X, VisualAttribute::Y, VisualAttribute::Width, VisualAttribute::Height}) {
+		CUI_CHECK(!rejects([attribute] { return UiCommand::set_attribute("node", attribute, 10); }));
+		CUI_CHECK(rejects([attribute] { return UiCommand::set_attribute("node", attribute, Color(255, 0, 0, 255)); }));
+	}
+	for (const auto attribute : {VisualAttribute::Background, VisualAttribute::TextColor}) {
+		CUI_CHECK(rejects([attribute] { return UiCommand::set_attribute("node", attribute, 10); }));
+		CUI_CHECK(!rejects([attribute] { return UiCommand::set_attribute("node", attribute, Color(255, 0, 0, 255)); }));
+	}
+	CUI_CHECK(rejects([] { return UiCommand::set_attribute("node", VisualAttribute::Text, 10); }));
+	CUI_CHECK(rejects([] { return UiCommand::set_attribute("node", VisualAttribute::Text, Color(255, 0, 0, 255)); }));
+
+	const auto command = UiCommand::set_attribute("node", VisualAttribute::Width, 10);
+	CUI_CHECK(command.kind() == UiCommand::Kind::SetAttribute);
+	CUI_CHECK(std::get<int>(command.value()) == 10);
+}
+
+int main() {
+	set_attribute_checks_the_value_kind();
+	return test::report();
+}
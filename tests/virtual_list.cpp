@@ -0,0 +1,146 @@
+#include <string>
+#include <vector>
+
+#include <test.hpp>
+#include <window.hpp>
+
+using namespace cui;
+using namespace std::chrono_literals;
+
+constexpr char styles__[] = R"(
+root {
+	background: rgb(116, 109, 105);
+}
+
+list {
+	background: rgb(40, 40, 40);
+	y: 50;
+	width: 300;
+	height: 100;
+}
+
+row {
+	background: rgb(80, 80, 80);
+	width: 300;
+	height: 20;
+}
+
+label {
+	background: rgb(200, 200, 200);
+	x: 10;
+	y: center;
+	width: 100;
+	height: 10;
+}
+)";
+
+constexpr char scene__[] = R"(
+list "list"
+	row "row"
+		label "label"
+)";
+
+/// \brief Every row and its children sit at the position of the item bound to the row
+bool rows_in_place(Window& window, const VirtualList& list) {
+	auto& graph = window.active_scene().graph();
+	auto& cache = window.cache();
+	const auto top = cache[*graph.find_index("list") + 1].getPosition().y;
+
+	bool placed = true;
+	for (const auto& row : list.rows()) {
+		const auto index = graph.find_index(row.name);
+		if (!index || row.item == VirtualList::npos) return false;
+
+		const auto y = top + static_cast<float>(row.item) * list.row_height() - list.scroll_offset();
+		const auto label = graph[*index].children().front();
+		placed = placed && cache[*index + 1].getPosition().y == y;
+		placed = placed && cache[label + 1].getPosition().y == y + 5;
+	}
+	return placed;
+}
+
+/// \brief Rows share the schematics of the template
+bool rows_shared(Window& window, const VirtualList& list) {
+	auto& graph = window.active_scene().graph();
+	for (const auto& row : list.rows()) {
+		const auto index = graph.find_index(row.name);
+		if (!index || !graph[*index].data().shares_schematics()) return false;
+	}
+	return true;
+}
+
+/// \brief Scrolling translates rows in the cache instead of writing their schematics
+void scrolling_keeps_schematics_shared() {
+	Window window(test::parse_styles<styles__>(), test::parse_scene<scene__>());
+	window.simulate(0ms, 1ms);
+
+	std::size_t binds = 0;
+	auto& list = window.virtualize("list", 1000, 20, [&binds](std::size_t, SceneGraph&, std::size_t) { ++binds; });
+	window.simulate(1ms, 1ms);
+	CUI_CHECK(!list.rows().empty());
+	CUI_CHECK(rows_in_place(window, list));
+	CUI_CHECK(rows_shared(window, list));
+
+	// Scrolling by less than a row rebinds nothing
+	const auto initial_binds = binds;
+	list.scroll_by(7);
+	window.simulate(1ms, 1ms);
+	CUI_CHECK(binds == initial_binds);
+	CUI_CHECK(rows_in_place(window, list));
+	CUI_CHECK(rows_shared(window, list));
+
+	list.scroll_to(555);
+	window.simulate(1ms, 1ms);
+	CUI_CHECK(binds > initial_binds);
+	CUI_CHECK(rows_in_place(window, list));
+	CUI_CHECK(rows_shared(window, list));
+
+	// A full cache update resets rows to their schematics, the lists place them again
+	window.schedule_to_update_cache();
+	window.simulate(1ms, 1ms);
+	CUI_CHECK(rows_in_place(window, list));
+}
+
+/// \brief Presses the left mouse button at a position of the window
+void press(Window& window, const int x, const int y) {
+	sf::Event event{};
+	event.type = sf::Event::MouseButtonPressed;
+	event.mouseButton = {sf::Mouse::Left, x, y};
+	window.process_event(event);
+}
+
+/// \brief Rows hidden below the viewport do not catch clicks next to the list
+void hidden_rows_ignore_clicks() {
+	Window window(test::parse_styles<styles__>(), test::parse_scene<scene__>());
+	window.simulate(0ms, 1ms);
+
+	std::vector<std::string> callers;
+	window.register_event(sf::Event::MouseButtonPressed, "click", [&callers](Window::event_data_t data) {
+		callers.push_back(data.caller()->name());
+	});
+	window.attach_event_to_node("row", "click");
+	auto& list = window.virtualize("list", 1000, 20, [](std::size_t, SceneGraph&, std::size_t) {});
+	window.simulate(1ms, 1ms);
+
+	// The overscan row right below the viewport is laid out but hidden
+	auto& graph = window.active_scene().graph();
+	auto& cache = window.cache();
+	bool hidden_row_below = false;
+	for (const auto& row : list.rows()) {
+		const auto& ve = cache[*graph.find_index(row.name) + 1];
+		hidden_row_below = hidden_row_below || (!ve.visible() && ve.getGlobalBounds().contains(200, 155));
+	}
+	CUI_CHECK(hidden_row_below);
+
+	press(window, 200, 155);
+	CUI_CHECK(callers.empty());
+
+	press(window, 200, 60);
+	CUI_CHECK(callers.size() == 1);
+}
+
+int main() {
+	scrolling_keeps_schematics_shared();
+	hidden_rows_ignore_clicks();
+	return test::report();
+}
@@ -0,0 +1,66 @@
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+#include <detail/worker_pool.hpp>
+#include <test.hpp>
+
+using namespace cui;
+
+/// \brief The tasks of a group all run before wait returns, the first exception is rethrown once
+void group_waits_and_rethrows() {
+	WorkerPool pool(2);
+	TaskGroup group(pool);
+
+	std::atomic<int> count{0};
+	for (int i = 0; i < 100; ++i) group.run([&count] { ++count; });
+	group.run([] { throw std::logic_error("task failed"); });
+
+	bool thrown = false;
+	try {
+		group.wait();
+	} catch (const std::logic_error&) {
+		thrown = true;
+	}
+	CUI_CHECK(thrown);
+	CUI_CHECK(count == 100);
+	CUI_CHECK(group.done());
+
+	group.wait();
+}
+
+/// \brief A task rejected by a stopped pool throws, leaves the group complete and is reported by wait
+void rejected_task_is_reported() {
+	WorkerPool pool(1);
+	TaskGroup group(pool);
+	pool.stop();
+
+	bool ran = false;
+	bool thrown = false;
+	try {
+		group.run([&ran] { ran = true; });
+	} catch (const std::runtime_error&) {
+		thrown = true;
+	}
+	CUI_CHECK(thrown);
+	CUI_CHECK(!ran);
+	CUI_CHECK(group.done());
+
+	// A waiter on another thread sees the failure instead of blocking
+	bool reported = false;
+	std::thread waiter([&group, &reported] {
+		try {
+			group.wait();
+		} catch (const std::runtime_error&) {
+			reported = true;
+		}
+	});
+	waiter.join();
+	CUI_CHECK(reported);
+}
+
+int main() {
+	group_waits_and_rethrows();
+	rejected_task_is_reported();
+	return test::report();
+}